@@ -17,6 +17,52 @@
   */
 #include "DS1307.h"
 
+static ds1307_status_t ds1307_i2c_transfer(ds1307_context_t *usr,
+		uint8_t write, ds1307_adr_t address, ds1307_reg_adr_t reg_adr,
+		uint8_t *ds1307_data, uint16_t size);
+static ds1307_status_t ds1307_i2c_send(ds1307_context_t *usr,
+		ds1307_adr_t address, ds1307_reg_adr_t reg_adr, uint8_t *ds1307_data,
+		uint16_t size);
+static ds1307_status_t ds1307_i2c_read(ds1307_context_t *usr,
+		ds1307_adr_t address, ds1307_reg_adr_t reg_adr, uint8_t *ds1307_data,
+		uint16_t size);
+static uint8_t DecToBcd(uint8_t value);
+static uint8_t BcdToDec(uint8_t value);
+static void ds1307_bcd_to_dec_image(uint8_t *data);
+static void ds1307_dec_to_bcd_image(uint8_t *data);
+static uint8_t ds1307_hour_to_24(const ds1307_context_t *usr);
+static uint8_t ds1307_raw_hour_to_24(uint8_t hour);
+static void ds1307_hour_from_24(ds1307_context_t *usr, uint8_t hour);
+static uint8_t ds1307_encode_hour(ds1307_context_t *usr, uint8_t hour);
+static void ds1307_decode_hour(ds1307_context_t *usr, uint8_t hour);
+static void ds1307_decode_date_time(ds1307_context_t *usr, const uint8_t *regs);
+static void ds1307_encode_date_time(ds1307_context_t *usr, uint8_t *regs);
+static void ds1307_decode_fields(ds1307_context_t *usr);
+static ds1307_status_t ds1307_nvram_transfer(ds1307_context_t *usr,
+		uint8_t offset, uint8_t *data, uint8_t length, uint8_t write);
+static ds1307_status_t ds1307_nvram_stream_transfer(
+		ds1307_nvram_stream_t *stream, uint8_t *data, uint8_t length,
+		uint8_t *count, uint8_t write);
+static ds1307_status_t ds1307_async_start(ds1307_context_t *usr,
+		ds1307_async_state_t state, ds1307_async_done_func_t done);
+#if DS1307_CONFIG_FIELD_API
+static ds1307_status_t ds1307_write_field(ds1307_context_t *usr,
+		ds1307_reg_adr_t reg_adr, uint8_t value);
+#endif
+#if DS1307_CONFIG_12H
+static ds1307_status_t ds1307_set_time_format_locked(ds1307_context_t *usr,
+		ds_1307_hour_format_t format);
+#endif
+static uint8_t ds1307_regs_valid(const uint8_t *regs);
+static void ds1307_init_marker(uint8_t *buf);
+static uint8_t ds1307_bcd_in_range(uint8_t value, uint8_t min, uint8_t max);
+static ds1307_status_t ds1307_set_ch_locked(ds1307_context_t *usr,
+		ds1307_clock_t clock);
+#if DS1307_CONFIG_STATS
+static void ds1307_stats_record(ds1307_context_t *usr, ds1307_reg_adr_t reg_adr,
+		uint16_t size, uint8_t retry, uint32_t start);
+#endif
+
 /**
   * @brief  Sends data to the DS1307 device over I2C.
   * @param  usr: Pointer to the DS1307 context structure that contains function pointers.
@@ -24,12 +70,13 @@
   * @param  reg_adr: Target register address within the DS1307 device.
   * @param  ds1307_data: Pointer to the data buffer to be sent.
   * @param  size: Number of bytes to send from the data buffer.
-  * @retval None
+  * @retval Status returned by the transport after the retry policy has been applied.
   */
-static void ds1307_i2c_send(ds1307_context_t *usr, ds1307_adr_t address,
-		ds1307_reg_adr_t reg_adr, uint8_t *ds1307_data, uint16_t size) {
+static ds1307_status_t ds1307_i2c_send(ds1307_context_t *usr,
+		ds1307_adr_t address, ds1307_reg_adr_t reg_adr, uint8_t *ds1307_data,
+		uint16_t size) {
 
-	usr->functions.ds1307_i2c_send_ptr(address, reg_adr, ds1307_data, size);
+	return ds1307_i2c_transfer(usr, 1, address, reg_adr, ds1307_data, size);
 
 }
 
@@ -40,68 +87,303 @@ static void ds1307_i2c_send(ds1307_context_t *usr, ds1307_adr_t address,
   * @param  reg_adr: Target register address within the DS1307 device.
   * @param  ds1307_data: Pointer to the buffer where the received data will be stored.
   * @param  size: Number of bytes to read from the device.
+  * @retval Status returned by the transport after the retry policy has been applied.
+  */
+static ds1307_status_t ds1307_i2c_read(ds1307_context_t *usr,
+		ds1307_adr_t address, ds1307_reg_adr_t reg_adr, uint8_t *ds1307_data,
+		uint16_t size) {
+
+	return ds1307_i2c_transfer(usr, 0, address, reg_adr, ds1307_data, size);
+
+}
+
+/**
+  * @brief  Runs a blocking transfer through the user transport with bounded retry and backoff.
+  * @param  usr: Pointer to the DS1307 context structure that contains function pointers.
+  * @param  write: Non-zero for a write transfer, zero for a read transfer.
+  * @param  address: I2C address of the DS1307 device.
+  * @param  reg_adr: Target register address within the DS1307 device.
+  * @param  ds1307_data: Pointer to the data buffer.
+  * @param  size: Number of bytes to transfer.
+  * @retval Status of the last attempt.
+  * @note   A failed transfer is repeated up to usr->functions.retries times. Before each retry the
+  *         optional usr->functions.delay_ms function is called, starting with
+  *         usr->functions.retry_delay_ms and doubling the delay for every further attempt.
+  *         @ref DS1307_INVALID_PARAM is never retried.
+  *         When DS1307_CONFIG_STATS is enabled every attempt is accounted in usr->stats.
+  *         The bus lock is held for all attempts.
+  */
+static ds1307_status_t ds1307_i2c_transfer(ds1307_context_t *usr,
+		uint8_t write, ds1307_adr_t address, ds1307_reg_adr_t reg_adr,
+		uint8_t *ds1307_data, uint16_t size) {
+	ds1307_status_t status;
+	uint32_t delay = usr->functions.retry_delay_ms;
+	uint8_t attempt = 0;
+#if DS1307_CONFIG_STATS
+	uint32_t start = 0;
+#endif
+
+	ds1307_lock(usr);
+	for (;;) {
+#if DS1307_CONFIG_STATS
+		if (usr->functions.cycles) {
+			start = usr->functions.cycles();
+		}
+#endif
+		if (write) {
+			status = usr->functions.ds1307_i2c_send_ptr(usr->functions.handle,
+					address, reg_adr, ds1307_data, size);
+		} else {
+			status = usr->functions.ds1307_i2c_read_ptr(usr->functions.handle,
+					address, reg_adr, ds1307_data, size);
+		}
+#if DS1307_CONFIG_STATS
+		ds1307_stats_record(usr, reg_adr, size, attempt != 0, start);
+#endif
+		if (status == DS1307_OK || status == DS1307_INVALID_PARAM
+				|| attempt >= usr->functions.retries) {
+#if DS1307_CONFIG_STATS
+			if (status != DS1307_OK) {
+				usr->stats.errors++;
+			}
+#endif
+			ds1307_unlock(usr);
+			return status;
+		}
+		attempt++;
+		if (usr->functions.delay_ms) {
+			usr->functions.delay_ms(delay);
+		}
+		delay <<= 1;
+	}
+}
+
+/**
+  * @brief  Takes the bus lock of the context.
+  * @param  usr: Pointer to the DS1307 context structure.
+  * @retval None
+  * @note   Calls usr->functions.lock if it is set. Use it to make a sequence of driver calls atomic
+  *         with respect to other tasks sharing the context or the bus; the driver itself takes the
+  *         lock around every transfer and every operation made of several transfers.
+  */
+void ds1307_lock(ds1307_context_t *usr) {
+	if (usr->functions.lock) {
+		usr->functions.lock(usr->functions.handle);
+	}
+}
+
+/**
+  * @brief  Releases the bus lock of the context.
+  * @param  usr: Pointer to the DS1307 context structure.
+  * @retval None
+  */
+void ds1307_unlock(ds1307_context_t *usr) {
+	if (usr->functions.unlock) {
+		usr->functions.unlock(usr->functions.handle);
+	}
+}
+
+#if DS1307_CONFIG_STATS
+/**
+  * @brief  Accounts one transport call in the statistics of the context.
+  * @param  usr: Pointer to the DS1307 context structure.
+  * @param  reg_adr: Start register of the transfer.
+  * @param  size: Number of bytes transferred.
+  * @param  retry: Non-zero if the call was a retry of a failed attempt.
+  * @param  start: Cycle counter value taken before the call.
+  * @retval None
+  */
+static void ds1307_stats_record(ds1307_context_t *usr, ds1307_reg_adr_t reg_adr,
+		uint16_t size, uint8_t retry, uint32_t start) {
+	ds1307_stats_t *stats = &usr->stats;
+	ds1307_reg_stats_t *slot = &stats->reg[
+			(reg_adr < DS1307_RAM_START_ADR) ? reg_adr : DS1307_RAM_START_ADR];
+	uint32_t latency;
+
+	slot->transactions++;
+	slot->bytes += size;
+	if (retry) {
+		slot->retries++;
+	}
+	if (usr->functions.cycles) {
+		latency = usr->functions.cycles() - start;
+		if (stats->latency_count == 0 || latency < stats->latency_min) {
+			stats->latency_min = latency;
+		}
+		if (latency > stats->latency_max) {
+			stats->latency_max = latency;
+		}
+		stats->latency_sum += latency;
+		stats->latency_count++;
+	}
+}
+
+/**
+  * @brief  Clears the bus usage statistics of a context.
+  * @param  usr: Pointer to the DS1307 context structure.
+  * @retval None
+  */
+void ds1307_stats_reset(ds1307_context_t *usr) {
+	ds1307_stats_t empty = { 0 };
+
+	usr->stats = empty;
+}
+
+/**
+  * @brief  Returns the average latency of the measured transport calls.
+  * @param  usr: Pointer to the DS1307 context structure.
+  * @retval Average latency in cycle counter ticks, 0 if no call has been measured.
+  */
+uint32_t ds1307_stats_avg_latency(const ds1307_context_t *usr) {
+	if (usr->stats.latency_count == 0) {
+		return 0;
+	}
+	return (uint32_t) (usr->stats.latency_sum / usr->stats.latency_count);
+}
+#endif
+
+#if DS1307_CONFIG_FIELD_API
+/**
+  * @brief  Stores an encoded register value in the raw image and writes it to the device.
+  * @param  usr: Pointer to the DS1307 context structure.
+  * @param  reg_adr: Timekeeping register address (@ref DS1307_SEC_REG_ADR to @ref DS1307_YEAR_REG_ADR).
+  * @param  value: Encoded (BCD) register value.
+  * @retval Status of the transfer (always @ref DS1307_OK in deferred mode).
+  * @note   In @ref DS1307_WRITE_DEFERRED mode the value is only marked dirty; it is written by
+  *         @ref ds1307_commit. In immediate mode the raw image is only updated when the write succeeds.
+  */
+static ds1307_status_t ds1307_write_field(ds1307_context_t *usr,
+		ds1307_reg_adr_t reg_adr, uint8_t value) {
+	ds1307_status_t status;
+
+	if (usr->write_mode != DS1307_WRITE_DEFERRED) {
+		status = ds1307_i2c_send(usr, DS1307_WRITE_ADR, reg_adr, &value, 1);
+		if (status != DS1307_OK) {
+			return status;
+		}
+	} else {
+		usr->dirty |= (1U << reg_adr);
+	}
+	usr->regs[reg_adr] = value;
+	usr->decoded &= ~(1U << reg_adr);
+	return DS1307_OK;
+}
+
+/**
+  * @brief  Selects whether the ds1307_set_* functions write immediately or defer until @ref ds1307_commit.
+  * @param  usr: Pointer to the DS1307 context structure.
+  * @param  mode: Write mode. This parameter can be one of the following values:
+  *         @arg DS1307_WRITE_IMMEDIATE: every setter starts its own I2C transfer (default)
+  *         @arg DS1307_WRITE_DEFERRED:  setters only update the raw image and mark the field dirty
   * @retval None
+  * @note   Switching back to immediate mode does not flush pending fields; call @ref ds1307_commit first.
   */
-static void ds1307_i2c_read(ds1307_context_t *usr, ds1307_adr_t address,
-		ds1307_reg_adr_t reg_adr, uint8_t *ds1307_data, uint16_t size) {
+void ds1307_set_write_mode(ds1307_context_t *usr, ds1307_write_mode_t mode) {
+	usr->write_mode = mode;
+}
 
-	usr->functions.ds1307_i2c_read_ptr(address, reg_adr, ds1307_data, size);
+/**
+  * @brief  Writes all dirty timekeeping fields to the DS1307 device in a single transfer.
+  * @param  usr: Pointer to the DS1307 context structure.
+  * @retval Status of the transfer.
+  * @note   The smallest contiguous register range covering every dirty field is written in one burst.
+  *         Clean registers inside that range are rewritten from the raw image, so the image should be
+  *         loaded with @ref DS1307_read_date_time or @ref ds1307_read_raw before setting fields that are
+  *         not adjacent. Does nothing when no field is dirty. The dirty fields are kept if the write fails.
+  */
+ds1307_status_t ds1307_commit(ds1307_context_t *usr) {
+	ds1307_status_t status;
+	uint8_t first = 0;
+	uint8_t last = DS1307_TIME_REG_COUNT - 1U;
 
+	if (usr->dirty == 0) {
+		return DS1307_OK;
+	}
+	while (!(usr->dirty & (1U << first))) {
+		first++;
+	}
+	while (!(usr->dirty & (1U << last))) {
+		last--;
+	}
+	status = ds1307_i2c_send(usr, DS1307_WRITE_ADR, (ds1307_reg_adr_t) first,
+			&usr->regs[first], (uint16_t) (last - first + 1U));
+	if (status == DS1307_OK) {
+		usr->dirty = 0;
+	}
+	return status;
 }
 
 /**
   * @brief  Sets the minute value on the DS1307 device.
   * @param  usr: Pointer to the DS1307 context structure.
   * @param  minute: Minute value to set (0 to 59), in decimal format.
-  * @retval None
+  * @retval Status of the transfer.
   */
-void ds1307_set_minute(ds1307_context_t *usr, uint8_t minute) {
+ds1307_status_t ds1307_set_minute(ds1307_context_t *usr, uint8_t minute) {
 	minute = DecToBcd(minute);
-	ds1307_i2c_send(usr, DS1307_WRITE_ADR, DS1307_MIN_REG_ADR, &minute, 1);
+	return ds1307_write_field(usr, DS1307_MIN_REG_ADR, minute);
 }
 
 /**
   * @brief  Reads the minute value from the DS1307 device and updates the context structure.
   * @param  usr: Pointer to the DS1307 context structure where the result will be stored.
-  * @retval None
+  * @retval Status of the transfer.
   */
-void ds1307_get_minute(ds1307_context_t *usr) {
+ds1307_status_t ds1307_get_minute(ds1307_context_t *usr) {
 	uint8_t minute = 0;
-	ds1307_i2c_read(usr, DS1307_READ_ADR, DS1307_MIN_REG_ADR, &minute, 1);
+	ds1307_status_t status = ds1307_i2c_read(usr, DS1307_READ_ADR,
+			DS1307_MIN_REG_ADR, &minute, 1);
+
+	if (status != DS1307_OK) {
+		return status;
+	}
+	usr->regs[DS1307_MIN_REG_ADR] = minute;
+	usr->decoded |= DS1307_FIELD_MINUTE;
 
 	usr->minute = BcdToDec(minute);
+	return DS1307_OK;
 }
 
 /**
   * @brief  Sets the second value on the DS1307 device.
   * @param  usr: Pointer to the DS1307 context structure.
   * @param  second: Second value to set (0 to 59), in decimal format.
-  * @retval None
+  * @retval Status of the transfer.
   */
-void ds1307_set_second(ds1307_context_t *usr, uint8_t second) {
+ds1307_status_t ds1307_set_second(ds1307_context_t *usr, uint8_t second) {
 	second = DecToBcd(second);
-	ds1307_i2c_send(usr, DS1307_WRITE_ADR, DS1307_SEC_REG_ADR, &second, 1);
+	return ds1307_write_field(usr, DS1307_SEC_REG_ADR, second);
 }
 
 /**
   * @brief  Reads the second value from the DS1307 device and updates the context structure.
   * @param  usr: Pointer to the DS1307 context structure where the result will be stored.
-  * @retval None
+  * @retval Status of the transfer.
   * @note   The CH (Clock Halt) bit [bit 7] is masked out during read.
   */
-void ds1307_get_second(ds1307_context_t *usr) {
+ds1307_status_t ds1307_get_second(ds1307_context_t *usr) {
 	uint8_t second = 0;
-	ds1307_i2c_read(usr, DS1307_READ_ADR, DS1307_SEC_REG_ADR, &second, 1);
+	ds1307_status_t status = ds1307_i2c_read(usr, DS1307_READ_ADR,
+			DS1307_SEC_REG_ADR, &second, 1);
+
+	if (status != DS1307_OK) {
+		return status;
+	}
+	usr->regs[DS1307_SEC_REG_ADR] = second;
+	usr->decoded |= DS1307_FIELD_SECOND;
 	second &= ~(1U << 7);
 	usr->second = BcdToDec(second);
+	return DS1307_OK;
 }
+#endif /* DS1307_CONFIG_FIELD_API */
 
 
+#if DS1307_CONFIG_FIELD_API
 /**
   * @brief  Sets the hour value on the DS1307 device according to the selected hour format (12H/24H).
   * @param  usr: Pointer to the DS1307 context structure.
   * @param  hour: Hour value to set. The value should always be provided in 24-hour format (0–23).
-  * @retval None
+  * @retval Status of the transfer.
   * @note   The hour value must be given in 24-hour format regardless of the current format setting.
   *         If the context is set to 12-hour format, the driver automatically converts the value to the correct 12H format with AM/PM.
   *         For example, passing 13 results in 1 PM being set when 12H mode is active.
@@ -109,51 +391,71 @@ void ds1307_get_second(ds1307_context_t *usr) {
   *         To change the hour format (12H or 24H), use the @ref ds1307_set_time_format function.
   * @see    ds1307_set_time_format
   */
-void ds1307_set_hour(ds1307_context_t *usr, uint8_t hour) {
-
-	if (usr->time_format == DS1307_HOUR_FORMAT_12) {
-
-		if (hour > 11) {
-			hour -= 12;
-			if (hour == 0) {
-				hour = 12;
-				hour = DecToBcd(hour);
-				hour |= (1U << 5);
-			} else if (hour == 12) {
-				hour = DecToBcd(hour);
-				hour &= ~(1U << 5);
-			} else {
-				hour = DecToBcd(hour);
-				hour |= (1U << 5);
-			}
-		} else if (hour == 0) {
-			hour += 12;
-		} else {
-			hour = DecToBcd(hour);
-			hour &= ~(1U << 5);
-		}
+ds1307_status_t ds1307_set_hour(ds1307_context_t *usr, uint8_t hour) {
+	hour = ds1307_encode_hour(usr, hour);
+	return ds1307_write_field(usr, DS1307_HOUR_REG_ADR, hour);
+}
+#endif /* DS1307_CONFIG_FIELD_API */
+
+/**
+  * @brief  Encodes a 24-hour value into the hour register layout selected by usr->time_format.
+  * @param  usr: Pointer to the DS1307 context structure.
+  * @param  hour: Hour value in 24-hour format (0–23).
+  * @retval Raw hour register content (BCD, with the 12H and PM flags when 12-hour format is active).
+  * @note   In 12-hour format hour 0 is encoded as 12 AM (0x52) and hour 12 as 12 PM (0x72).
+  */
+static uint8_t ds1307_encode_hour(ds1307_context_t *usr, uint8_t hour) {
+	uint8_t period;
+
+	if (DS1307_CONFIG_12H && usr->time_format == DS1307_HOUR_FORMAT_12) {
 
-		hour |= (1U << 6);
-		ds1307_i2c_send(usr, DS1307_WRITE_ADR, DS1307_HOUR_REG_ADR, &hour, 1);
+		period = (hour > 11) ? (1U << 5) : 0U;
+		hour %= 12;
+		if (hour == 0) {
+			hour = 12;
+		}
+		hour = DecToBcd(hour) | period | (1U << 6);
 	} else {
 		hour = DecToBcd(hour);
-		ds1307_i2c_send(usr, DS1307_WRITE_ADR, DS1307_HOUR_REG_ADR, &hour, 1);
 	}
+
+	return hour;
 }
 
+#if DS1307_CONFIG_FIELD_API
 /**
   * @brief  Reads the hour value from the DS1307 device and updates the context structure.
   * @param  usr: Pointer to the DS1307 context structure where the hour, time format, and AM/PM status will be stored.
-  * @retval None
+  * @retval Status of the transfer.
   * @note   Updates usr->hour, usr->time_format, and usr->time_period based on the DS1307 hour register content.
   */
-void ds1307_get_hour(ds1307_context_t *usr) {
+ds1307_status_t ds1307_get_hour(ds1307_context_t *usr) {
 	uint8_t hour = 0;
-	ds1307_i2c_read(usr, DS1307_READ_ADR, DS1307_HOUR_REG_ADR, &hour, 1);
-	usr->time_format = (ds_1307_hour_format_t) ((hour & 0x40) >> 6);
+	ds1307_status_t status = ds1307_i2c_read(usr, DS1307_READ_ADR,
+			DS1307_HOUR_REG_ADR, &hour, 1);
+
+	if (status != DS1307_OK) {
+		return status;
+	}
+	usr->regs[DS1307_HOUR_REG_ADR] = hour;
+	usr->decoded |= DS1307_FIELD_HOUR;
+	ds1307_decode_hour(usr, hour);
+	return DS1307_OK;
+}
+#endif /* DS1307_CONFIG_FIELD_API */
+
+/**
+  * @brief  Decodes a raw hour register value into the context structure.
+  * @param  usr: Pointer to the DS1307 context structure where the hour, time format, and AM/PM status will be stored.
+  * @param  hour: Raw hour register content as read from the device.
+  * @retval None
+  */
+static void ds1307_decode_hour(ds1307_context_t *usr, uint8_t hour) {
+	usr->time_format = DS1307_CONFIG_12H ?
+			(ds_1307_hour_format_t) ((hour & 0x40) >> 6) : DS1307_HOUR_FORMAT_24;
 	hour &= ~(1U << 6);
 
-	if (usr->time_format == DS1307_HOUR_FORMAT_12) {
+	if (DS1307_CONFIG_12H && usr->time_format == DS1307_HOUR_FORMAT_12) {
 
 		usr->time_period = ((hour & 0x20) >> 5);
 		hour &= ~(1U << 5);
@@ -165,75 +467,212 @@ void ds1307_get_hour(ds1307_context_t *usr) {
 }
 
 
+#if DS1307_CONFIG_12H
 /**
   * @brief  Sets the hour format (12-hour or 24-hour) for the DS1307 device.
   * @param  usr: Pointer to the DS1307 context structure.
   * @param  format: Desired hour format. This parameter can be one of the following values:
   *         @arg DS1307_HOUR_FORMAT_12: 12-hour format
   *         @arg DS1307_HOUR_FORMAT_24: 24-hour format
-  * @retval None
-  * @note   This function reads the current time from the device and converts the existing values
-  *         to match the selected hour format. A small time drift (1–2 seconds) may occur due to
-  *         read-modify-write operations.
-  *         If precise timing is critical, it is recommended to reconfigure the date and time
-  *         after using this function.
+  * @retval Status of the first failing transfer, or @ref DS1307_OK.
+  * @note   The seconds, minutes and hours registers are read in one burst, the hour is converted to
+  *         the selected layout and only the hour register is written back. The oscillator is not
+  *         halted and the other registers are not touched, so no time is lost.
+  *         If the burst was read at xx:59:59, the registers are read again after the write: when
+  *         the minute has rolled over but the hour still holds the written value, the hour
+  *         increment was lost and the next hour is written.
+  *         usr->second, usr->minute, usr->hour, usr->time_format and usr->time_period are updated.
+  *         The bus lock is held for the whole operation.
   * @see    ds1307_set_hour
   */
-void ds1307_set_time_format(ds1307_context_t *usr, ds_1307_hour_format_t format) {
-	ds1307_get_hour(usr);
-	if (usr->time_format != format) {
-		ds1307_set_ch(usr, DS1307_CLOCK_DISABLE);
-		switch (format) {
-		case DS1307_HOUR_FORMAT_12:
-			usr->time_format = DS1307_HOUR_FORMAT_12;
-			break;
-		case DS1307_HOUR_FORMAT_24:
-			usr->time_format = DS1307_HOUR_FORMAT_24;
-			if (usr->time_period == DS1307_PM) {
-				if (usr->hour != 12) {
-					usr->hour += 12;
-				}
-			} else {
-				if (usr->hour == 12) {
-					usr->hour = 0;
+ds1307_status_t ds1307_set_time_format(ds1307_context_t *usr,
+		ds_1307_hour_format_t format) {
+	ds1307_status_t status;
+
+	ds1307_lock(usr);
+	status = ds1307_set_time_format_locked(usr, format);
+	ds1307_unlock(usr);
+	return status;
+}
+
+/**
+  * @brief  Hour format conversion sequence, called with the bus lock held.
+  * @param  usr: Pointer to the DS1307 context structure.
+  * @param  format: Desired hour format.
+  * @retval Same as @ref ds1307_set_time_format.
+  */
+static ds1307_status_t ds1307_set_time_format_locked(ds1307_context_t *usr,
+		ds_1307_hour_format_t format) {
+	uint8_t regs[DS1307_HOUR_REG_ADR + 1U];
+	uint8_t check[DS1307_HOUR_REG_ADR + 1U];
+	uint8_t hour;
+	uint8_t hour_24;
+	uint8_t i;
+	ds_1307_hour_format_t previous;
+	ds1307_status_t status = ds1307_i2c_read(usr, DS1307_READ_ADR,
+			DS1307_SEC_REG_ADR, regs, sizeof(regs));
+
+	if (status != DS1307_OK) {
+		return status;
+	}
+	hour_24 = ds1307_raw_hour_to_24(regs[DS1307_HOUR_REG_ADR]);
+
+	if ((ds_1307_hour_format_t) ((regs[DS1307_HOUR_REG_ADR] & 0x40) >> 6)
+			!= format) {
+		previous = usr->time_format;
+		usr->time_format = format;
+		hour = ds1307_encode_hour(usr, hour_24);
+		status = ds1307_i2c_send(usr, DS1307_WRITE_ADR, DS1307_HOUR_REG_ADR,
+				&hour, 1);
+		if (status != DS1307_OK) {
+			usr->time_format = previous;
+			return status;
+		}
+		regs[DS1307_HOUR_REG_ADR] = hour;
+
+		if (regs[DS1307_SEC_REG_ADR] == 0x59 && regs[DS1307_MIN_REG_ADR] == 0x59) {
+			status = ds1307_i2c_read(usr, DS1307_READ_ADR, DS1307_SEC_REG_ADR,
+					check, sizeof(check));
+			if (status != DS1307_OK) {
+				return status;
+			}
+			if (check[DS1307_MIN_REG_ADR] != 0x59
+					&& check[DS1307_HOUR_REG_ADR] == hour) {
+				hour = ds1307_encode_hour(usr, (uint8_t) ((hour_24 + 1U) % 24U));
+				status = ds1307_i2c_send(usr, DS1307_WRITE_ADR,
+						DS1307_HOUR_REG_ADR, &hour, 1);
+				if (status != DS1307_OK) {
+					return status;
 				}
+				check[DS1307_HOUR_REG_ADR] = hour;
+			}
+			for (i = 0; i < sizeof(regs); i++) {
+				regs[i] = check[i];
 			}
-
-			break;
-		default:
-			break;
 		}
-		ds1307_set_year(usr, usr->year);
-		ds1307_set_month(usr, usr->month);
-		ds1307_set_date(usr, usr->date);
-		ds1307_set_day(usr, usr->day);
-		ds1307_set_hour(usr, usr->hour);
-		ds1307_set_minute(usr, usr->minute);
-		ds1307_set_second(usr, usr->second);
 	}
 
+	for (i = 0; i < sizeof(regs); i++) {
+		usr->regs[i] = regs[i];
+	}
+	usr->decoded &= ~(DS1307_FIELD_SECOND | DS1307_FIELD_MINUTE
+			| DS1307_FIELD_HOUR);
+	usr->dirty &= ~DS1307_FIELD_HOUR;
+	ds1307_second(usr);
+	ds1307_minute(usr);
+	ds1307_hour(usr);
+	return DS1307_OK;
+}
+#endif /* DS1307_CONFIG_12H */
+
+/**
+  * @brief  Writes the full date and time held in the context structure to the DS1307 device.
+  * @param  usr: Pointer to the DS1307 context structure holding the values to write.
+  * @retval Status of the transfer.
+  * @note   All seven timekeeping registers are encoded into one BCD buffer and written in a single
+  *         burst starting at @ref DS1307_SEC_REG_ADR, so the device never holds a partially updated time.
+  *         usr->hour is taken in the notation of usr->time_format, as the read functions leave it:
+  *         0–23 in 24-hour format, or 1–12 with usr->time_period in 12-hour format. A context read
+  *         from the device can therefore be written back unchanged. usr->century is updated from
+  *         usr->year as in @ref ds1307_set_year.
+  *         Writing the seconds register clears the CH bit, so the oscillator is started.
+  *         On success the raw image in usr->regs is updated and any pending deferred writes are superseded.
+  * @see    ds1307_set_date_time_clock
+  */
+ds1307_status_t ds1307_set_date_time(ds1307_context_t *usr) {
+	return ds1307_set_date_time_clock(usr, DS1307_CLOCK_ENABLE);
+}
+
+/**
+  * @brief  Writes the full date and time held in the context structure and sets the oscillator state in the same burst.
+  * @param  usr: Pointer to the DS1307 context structure holding the values to write.
+  * @param  clock: Oscillator state to write with the seconds register. This parameter can be one of the following values:
+  *         @arg DS1307_CLOCK_ENABLE:  Sets the time and starts the oscillator (CH = 0)
+  *         @arg DS1307_CLOCK_DISABLE: Sets the time with the oscillator halted (CH = 1)
+  * @retval Status of the transfer.
+  * @note   Same encoding rules as @ref ds1307_set_date_time. The CH bit is part of the seconds byte of the
+  *         burst, so no separate @ref ds1307_set_ch transfer is needed and the clock starts exactly at the
+  *         written second.
+  */
+ds1307_status_t ds1307_set_date_time_clock(ds1307_context_t *usr,
+		ds1307_clock_t clock) {
+	uint8_t regs[DS1307_TIME_REG_COUNT];
+	ds1307_status_t status;
+	uint8_t i;
+
+	ds1307_encode_date_time(usr, regs);
+	if (clock == DS1307_CLOCK_DISABLE) {
+		regs[DS1307_SEC_REG_ADR] |= (1U << 7);
+	}
+	status = ds1307_i2c_send(usr, DS1307_WRITE_ADR, DS1307_SEC_REG_ADR, regs,
+			DS1307_TIME_REG_COUNT);
+	if (status != DS1307_OK) {
+		return status;
+	}
+	for (i = 0; i < DS1307_TIME_REG_COUNT; i++) {
+		usr->regs[i] = regs[i];
+	}
+	usr->decoded = 0;
+	usr->dirty = 0;
+	return DS1307_OK;
+}
+
+/**
+  * @brief  Encodes the date and time held in the context structure into a raw timekeeping register image.
+  * @param  usr: Pointer to the DS1307 context structure holding the values to encode.
+  * @param  regs: Destination buffer of DS1307_TIME_REG_COUNT bytes, starting at @ref DS1307_SEC_REG_ADR.
+  * @retval None
+  * @note   usr->hour is interpreted according to usr->time_format and usr->time_period
+  *         (see @ref ds1307_set_date_time). usr->century is updated from usr->year as in @ref ds1307_set_year.
+  */
+static void ds1307_encode_date_time(ds1307_context_t *usr, uint8_t *regs) {
+	uint8_t year_8bit = (uint8_t) (usr->year % 100);
+
+#if DS1307_CONFIG_CENTURY
+	usr->century = usr->year - ((uint16_t) year_8bit);
+#endif
+
+	regs[DS1307_SEC_REG_ADR] = usr->second;
+	regs[DS1307_MIN_REG_ADR] = usr->minute;
+	regs[DS1307_HOUR_REG_ADR] = 0;
+	regs[DS1307_DAY_REG_ADR] = (uint8_t) usr->day;
+	regs[DS1307_DATE_REG_ADR] = usr->date;
+	regs[DS1307_MONTH_REG_ADR] = (uint8_t) usr->month;
+	regs[DS1307_YEAR_REG_ADR] = year_8bit;
+	ds1307_dec_to_bcd_image(regs);
+
+	regs[DS1307_HOUR_REG_ADR] = ds1307_encode_hour(usr, ds1307_hour_to_24(usr));
 }
 
+#if DS1307_CONFIG_FIELD_API
 /**
   * @brief  Sets the day of the month (date) value on the DS1307 device.
   * @param  usr: Pointer to the DS1307 context structure.
   * @param  date: Day of the month to set (1 to 31), in decimal format.
-  * @retval None
+  * @retval Status of the transfer.
   */
-void ds1307_set_date(ds1307_context_t *usr, uint8_t date) {
+ds1307_status_t ds1307_set_date(ds1307_context_t *usr, uint8_t date) {
 	date = DecToBcd(date);
-	ds1307_i2c_send(usr, DS1307_WRITE_ADR, DS1307_DATE_REG_ADR, &date, 1);
+	return ds1307_write_field(usr, DS1307_DATE_REG_ADR, date);
 }
 
 /**
   * @brief  Reads the day of the month (date) value from the DS1307 device and updates the context structure.
   * @param  usr: Pointer to the DS1307 context structure where the result will be stored.
-  * @retval None
+  * @retval Status of the transfer.
   */
-void ds1307_get_date(ds1307_context_t *usr) {
+ds1307_status_t ds1307_get_date(ds1307_context_t *usr) {
 	uint8_t date = 0;
-	ds1307_i2c_read(usr, DS1307_READ_ADR, DS1307_DATE_REG_ADR, &date, 1);
+	ds1307_status_t status = ds1307_i2c_read(usr, DS1307_READ_ADR,
+			DS1307_DATE_REG_ADR, &date, 1);
+
+	if (status != DS1307_OK) {
+		return status;
+	}
+	usr->regs[DS1307_DATE_REG_ADR] = date;
+	usr->decoded |= DS1307_FIELD_DATE;
 	usr->date = (ds1307_day_t) BcdToDec(date);
+	return DS1307_OK;
 }
 
 /**
@@ -241,23 +680,31 @@ void ds1307_get_date(ds1307_context_t *usr) {
   * @param  usr: Pointer to the DS1307 context structure.
   * @param  day: Day of the week to set. This parameter can be one of the values defined in @ref ds1307_day_t
   *              (1 = Monday, ..., 7 = Sunday).
-  * @retval None
+  * @retval Status of the transfer.
   */
-void ds1307_set_day(ds1307_context_t *usr, ds1307_day_t day) {
+ds1307_status_t ds1307_set_day(ds1307_context_t *usr, ds1307_day_t day) {
 	uint8_t day_8bit = (uint8_t) DecToBcd(day);
-	ds1307_i2c_send(usr, DS1307_WRITE_ADR, DS1307_DAY_REG_ADR, &day_8bit, 1);
+	return ds1307_write_field(usr, DS1307_DAY_REG_ADR, day_8bit);
 }
 
 /**
   * @brief  Reads the day of the week from the DS1307 device and updates the context structure.
   * @param  usr: Pointer to the DS1307 context structure where the result will be stored.
-  * @retval None
+  * @retval Status of the transfer.
   * @note   The day value follows the format: 1 = Monday, ..., 7 = Sunday.
   */
-void ds1307_get_day(ds1307_context_t *usr) {
+ds1307_status_t ds1307_get_day(ds1307_context_t *usr) {
 	uint8_t day = 0;
-	ds1307_i2c_read(usr, DS1307_READ_ADR, DS1307_DAY_REG_ADR, &day, 1);
+	ds1307_status_t status = ds1307_i2c_read(usr, DS1307_READ_ADR,
+			DS1307_DAY_REG_ADR, &day, 1);
+
+	if (status != DS1307_OK) {
+		return status;
+	}
+	usr->regs[DS1307_DAY_REG_ADR] = day;
+	usr->decoded |= DS1307_FIELD_DAY;
 	usr->day = (ds1307_day_t) BcdToDec(day);
+	return DS1307_OK;
 }
 
 /**
@@ -265,25 +712,32 @@ void ds1307_get_day(ds1307_context_t *usr) {
   * @param  usr: Pointer to the DS1307 context structure.
   * @param  month: Month value to set. This parameter can be one of the values defined in @ref ds1307_month_t
   *                (1 = January, ..., 12 = December).
-  * @retval None
+  * @retval Status of the transfer.
   */
 
-void ds1307_set_month(ds1307_context_t *usr, ds1307_month_t month) {
+ds1307_status_t ds1307_set_month(ds1307_context_t *usr, ds1307_month_t month) {
 	uint8_t month_8bit = (uint8_t) DecToBcd(month);
-	ds1307_i2c_send(usr, DS1307_WRITE_ADR, DS1307_MONTH_REG_ADR, &month_8bit,
-			1);
+	return ds1307_write_field(usr, DS1307_MONTH_REG_ADR, month_8bit);
 }
 
 /**
   * @brief  Reads the month value from the DS1307 device and updates the context structure.
   * @param  usr: Pointer to the DS1307 context structure where the result will be stored.
-  * @retval None
+  * @retval Status of the transfer.
   * @note   The month value is interpreted as: 1 = January, ..., 12 = December.
   */
-void ds1307_get_month(ds1307_context_t *usr) {
+ds1307_status_t ds1307_get_month(ds1307_context_t *usr) {
 	uint8_t month = 0;
-	ds1307_i2c_read(usr, DS1307_READ_ADR, DS1307_MONTH_REG_ADR, &month, 1);
+	ds1307_status_t status = ds1307_i2c_read(usr, DS1307_READ_ADR,
+			DS1307_MONTH_REG_ADR, &month, 1);
+
+	if (status != DS1307_OK) {
+		return status;
+	}
+	usr->regs[DS1307_MONTH_REG_ADR] = month;
+	usr->decoded |= DS1307_FIELD_MONTH;
 	usr->month = (ds1307_month_t) BcdToDec(month);
+	return DS1307_OK;
 }
 
 /**
@@ -291,89 +745,1238 @@ void ds1307_get_month(ds1307_context_t *usr) {
   * @param  usr: Pointer to the DS1307 context structure.
   * @param  year: Full year value to set (e.g., 2024). Only the last two digits are written to the device,
   *               and the century part is stored internally in usr->century.
-  * @retval None
+  * @retval Status of the transfer.
   * @note   The DS1307 device stores only the last two digits of the year.
   *         The higher part (century) is calculated and stored separately in usr->century for full year tracking.
   */
-void ds1307_set_year(ds1307_context_t *usr, uint16_t year) {
+ds1307_status_t ds1307_set_year(ds1307_context_t *usr, uint16_t year) {
 	uint8_t year_8bit = (uint8_t) (year % 100);
+#if DS1307_CONFIG_CENTURY
 	usr->century = year - ((uint16_t) year_8bit);
+#endif
 	year_8bit = DecToBcd(year_8bit);
-	ds1307_i2c_send(usr, DS1307_WRITE_ADR, DS1307_YEAR_REG_ADR, &year_8bit, 1);
+	return ds1307_write_field(usr, DS1307_YEAR_REG_ADR, year_8bit);
 }
 
 /**
   * @brief  Reads the year value from the DS1307 device and updates the context structure.
   * @param  usr: Pointer to the DS1307 context structure where the result will be stored.
-  * @retval None
+  * @retval Status of the transfer.
   * @note   The final full year is reconstructed by combining usr->century and the 2-digit year read from the device.
   */
-void ds1307_get_year(ds1307_context_t *usr) {
+ds1307_status_t ds1307_get_year(ds1307_context_t *usr) {
 	uint8_t year = 0;
-	ds1307_i2c_read(usr, DS1307_READ_ADR, DS1307_YEAR_REG_ADR, &year, 1);
-	usr->year = usr->century + ((uint16_t) BcdToDec(year));
+	ds1307_status_t status = ds1307_i2c_read(usr, DS1307_READ_ADR,
+			DS1307_YEAR_REG_ADR, &year, 1);
 
+	if (status != DS1307_OK) {
+		return status;
+	}
+	usr->regs[DS1307_YEAR_REG_ADR] = year;
+	usr->decoded |= DS1307_FIELD_YEAR;
+	usr->year = DS1307_CENTURY(usr) + ((uint16_t) BcdToDec(year));
+	return DS1307_OK;
 }
+#endif /* DS1307_CONFIG_FIELD_API */
 
 /**
-  * @brief  Enables or disables the DS1307 oscillator by setting the CH (Clock Halt) bit.
+  * @brief  Configures the SQW/OUT pin of the DS1307 device.
   * @param  usr: Pointer to the DS1307 context structure.
-  * @param  clock: Clock state to set. This parameter can be one of the following values:
-  *         @arg DS1307_CLOCK_ENABLE:  Enables the oscillator (CH = 0)
-  *         @arg DS1307_CLOCK_DISABLE: Disables the oscillator (CH = 1)
-  * @retval None
-  * @note   Disabling the clock stops the timekeeping functions. This may be used to pause time updates during configuration.
-  *         The CH bit is located in bit 7 of the seconds register.
+  * @param  sqw: Pin configuration. This parameter can be one of the values defined in @ref ds1307_sqw_t.
+  * @retval Status of the transfer.
+  * @note   The SQW/OUT pin is open drain and requires an external pull-up resistor.
+  *         If the RAM marker of @ref ds1307_init is in place (usr->marked), it is rewritten in the same
+  *         transfer so that its CRC matches the new control register value.
   */
-void ds1307_set_ch(ds1307_context_t *usr, ds1307_clock_t clock) {
-	uint8_t ch = 0;
-	if (clock == DS1307_CLOCK_DISABLE) {
-		ch |= (1U << 7);
-		ds1307_i2c_send(usr, DS1307_WRITE_ADR, DS1307_SEC_REG_ADR, &ch, 1);
-	} else {
-		ch &= ~(1U << 7);
-		ds1307_i2c_send(usr, DS1307_WRITE_ADR, DS1307_SEC_REG_ADR, &ch, 1);
+ds1307_status_t ds1307_set_sqw(ds1307_context_t *usr, ds1307_sqw_t sqw) {
+	uint8_t buf[1U + DS1307_INIT_MAGIC_SIZE];
+	uint8_t size = 1;
+	ds1307_status_t status;
+
+	buf[0] = (uint8_t) sqw;
+	if (usr->marked) {
+		ds1307_init_marker(buf);
+		size += DS1307_INIT_MAGIC_SIZE;
+	}
+	status = ds1307_i2c_send(usr, DS1307_WRITE_ADR, DS1307_CONT_REG_ADR, buf,
+			size);
+	if (status == DS1307_OK) {
+		usr->sqw = sqw;
+	}
+	return status;
+}
+
+/**
+  * @brief  Reads the SQW/OUT pin configuration from the DS1307 device and updates the context structure.
+  * @param  usr: Pointer to the DS1307 context structure where the result will be stored.
+  * @retval Status of the transfer.
+  * @note   Unused control register bits are masked out.
+  */
+ds1307_status_t ds1307_get_sqw(ds1307_context_t *usr) {
+	uint8_t control = 0;
+	ds1307_status_t status = ds1307_i2c_read(usr, DS1307_READ_ADR,
+			DS1307_CONT_REG_ADR, &control, 1);
+
+	if (status == DS1307_OK) {
+		usr->sqw = (ds1307_sqw_t) (control & 0x93);
 	}
+	return status;
+}
 
+/**
+  * @brief  Reads bytes from the battery-backed RAM of the DS1307 device.
+  * @param  usr: Pointer to the DS1307 context structure.
+  * @param  offset: Offset within the RAM (0 to 55).
+  * @param  data: Pointer to the buffer where the received data will be stored.
+  * @param  length: Number of bytes to read.
+  * @retval Status of the transfer, @ref DS1307_INVALID_PARAM if the range does not fit in the RAM.
+  * @note   The request is rejected if it does not fit in the 56-byte RAM, so the register pointer
+  *         never wraps into the timekeeping registers. Transfers are split into chunks of at most
+  *         usr->functions.max_transfer_size bytes.
+  */
+ds1307_status_t ds1307_nvram_read(ds1307_context_t *usr, uint8_t offset,
+		uint8_t *data, uint8_t length) {
+	return ds1307_nvram_transfer(usr, offset, data, length, 0);
 }
 
 /**
-  * @brief  Reads the full date and time information from the DS1307 device and updates the context structure.
-  * @param  usr: Pointer to the DS1307 context structure where the date and time values will be stored.
+  * @brief  Writes bytes to the battery-backed RAM of the DS1307 device.
+  * @param  usr: Pointer to the DS1307 context structure.
+  * @param  offset: Offset within the RAM (0 to 55).
+  * @param  data: Pointer to the data buffer to write.
+  * @param  length: Number of bytes to write.
+  * @retval Status of the transfer, @ref DS1307_INVALID_PARAM if the range does not fit in the RAM.
+  * @note   Same range and chunking rules as @ref ds1307_nvram_read.
+  */
+ds1307_status_t ds1307_nvram_write(ds1307_context_t *usr, uint8_t offset,
+		uint8_t *data, uint8_t length) {
+	return ds1307_nvram_transfer(usr, offset, data, length, 1);
+}
+
+/**
+  * @brief  Initializes a sequential NVRAM stream.
+  * @param  stream: Pointer to the stream structure to initialize.
+  * @param  usr: Pointer to the DS1307 context structure used for I2C access.
+  * @param  offset: RAM offset of the first byte (0 to 55).
   * @retval None
-  * @note   This function sequentially reads year, month, date, day, hour, minute, and second values
-  *         from the DS1307 and populates the corresponding fields in the context structure.
   */
-void DS1307_read_date_time(ds1307_context_t *usr) {
+void ds1307_nvram_stream_open(ds1307_nvram_stream_t *stream,
+		ds1307_context_t *usr, uint8_t offset) {
+	stream->usr = usr;
+	stream->offset = offset;
+}
 
-	ds1307_get_year(usr);
-	ds1307_get_month(usr);
-	ds1307_get_date(usr);
-	ds1307_get_day(usr);
-	ds1307_get_hour(usr);
-	ds1307_get_minute(usr);
-	ds1307_get_second(usr);
+/**
+  * @brief  Reads the next bytes of an NVRAM stream and advances it.
+  * @param  stream: Pointer to the stream structure.
+  * @param  data: Pointer to the buffer where the received data will be stored.
+  * @param  length: Number of bytes requested.
+  * @param  count: Optional pointer receiving the number of bytes read (may be NULL).
+  * @retval Status of the transfer.
+  * @note   The request is clipped at the end of the RAM, so *count may be less than length.
+  *         The stream only advances when the transfer succeeds.
+  */
+ds1307_status_t ds1307_nvram_stream_read(ds1307_nvram_stream_t *stream,
+		uint8_t *data, uint8_t length, uint8_t *count) {
+	return ds1307_nvram_stream_transfer(stream, data, length, count, 0);
+}
 
+/**
+  * @brief  Writes the next bytes of an NVRAM stream and advances it.
+  * @param  stream: Pointer to the stream structure.
+  * @param  data: Pointer to the data buffer to write.
+  * @param  length: Number of bytes to write.
+  * @param  count: Optional pointer receiving the number of bytes written (may be NULL).
+  * @retval Status of the transfer.
+  * @note   Same clipping rules as @ref ds1307_nvram_stream_read.
+  */
+ds1307_status_t ds1307_nvram_stream_write(ds1307_nvram_stream_t *stream,
+		uint8_t *data, uint8_t length, uint8_t *count) {
+	return ds1307_nvram_stream_transfer(stream, data, length, count, 1);
 }
 
 /**
-  * @brief  Converts a BCD (Binary-Coded Decimal) value to decimal.
-  * @param  value: 8-bit BCD value to convert.
-  * @retval Decimal representation of the input BCD value.
+  * @brief  Computes the CRC-8 (polynomial 0x07, initial value 0x00) of a buffer.
+  * @param  data: Pointer to the data buffer.
+  * @param  length: Number of bytes.
+  * @retval CRC-8 value.
+  * @note   Shared by the modules that keep checked records in NVRAM (DS1307_journal, DS1307_calib).
   */
-static uint8_t BcdToDec(uint8_t value) {
+uint8_t ds1307_crc8(const uint8_t *data, uint8_t length) {
+	uint8_t crc = 0;
+	uint8_t bit;
 
-	return ((((value & 0xf0) >> 4) * 10) + (value & 0x0f));
+	while (length--) {
+		crc ^= *data++;
+		for (bit = 0; bit < 8U; bit++) {
+			crc = (crc & 0x80U) ? (uint8_t) ((crc << 1) ^ 0x07U) : (uint8_t) (crc << 1);
+		}
+	}
+	return crc;
+}
+
+/**
+  * @brief  Transfers the next bytes of an NVRAM stream, clipped at the end of the RAM.
+  * @param  stream: Pointer to the stream structure.
+  * @param  data: Pointer to the data buffer.
+  * @param  length: Number of bytes requested.
+  * @param  count: Optional pointer receiving the number of bytes transferred (may be NULL).
+  * @param  write: Non-zero to write, zero to read.
+  * @retval Status of the transfer.
+  */
+static ds1307_status_t ds1307_nvram_stream_transfer(
+		ds1307_nvram_stream_t *stream, uint8_t *data, uint8_t length,
+		uint8_t *count, uint8_t write) {
+	ds1307_status_t status = DS1307_OK;
 
+	if (stream->offset >= DS1307_RAM_SIZE) {
+		length = 0;
+	} else if (length > DS1307_RAM_SIZE - stream->offset) {
+		length = (uint8_t) (DS1307_RAM_SIZE - stream->offset);
+	}
+	if (length > 0) {
+		status = ds1307_nvram_transfer(stream->usr, stream->offset, data,
+				length, write);
+		if (status == DS1307_OK) {
+			stream->offset += length;
+		} else {
+			length = 0;
+		}
+	}
+	if (count) {
+		*count = length;
+	}
+	return status;
 }
 
 /**
-  * @brief  Converts a decimal value to BCD (Binary-Coded Decimal) format.
-  * @param  value: 8-bit decimal value to convert (0 to 99).
-  * @retval BCD representation of the input decimal value.
+  * @brief  Transfers a range of the battery-backed RAM in chunks supported by the transport.
+  * @param  usr: Pointer to the DS1307 context structure.
+  * @param  offset: Offset within the RAM.
+  * @param  data: Pointer to the data buffer.
+  * @param  length: Number of bytes to transfer.
+  * @param  write: Non-zero to write, zero to read.
+  * @retval Status of the first failing chunk, @ref DS1307_INVALID_PARAM if the range does not fit in the RAM.
+  * @note   The bus lock is held for all chunks.
   */
-static uint8_t DecToBcd(uint8_t value) {
+static ds1307_status_t ds1307_nvram_transfer(ds1307_context_t *usr,
+		uint8_t offset, uint8_t *data, uint8_t length, uint8_t write) {
+	ds1307_status_t status;
+	uint16_t chunk;
+	uint16_t limit = usr->functions.max_transfer_size;
 
-	return (((value / 10) << 4) + (value % 10));
+	if (offset >= DS1307_RAM_SIZE || length > DS1307_RAM_SIZE - offset) {
+		return DS1307_INVALID_PARAM;
+	}
+	status = DS1307_OK;
+	ds1307_lock(usr);
+	while (length > 0) {
+		chunk = (limit != 0 && length > limit) ? limit : length;
+		if (write) {
+			status = ds1307_i2c_send(usr, DS1307_WRITE_ADR,
+					(ds1307_reg_adr_t) (DS1307_RAM_START_ADR + offset), data,
+					chunk);
+		} else {
+			status = ds1307_i2c_read(usr, DS1307_READ_ADR,
+					(ds1307_reg_adr_t) (DS1307_RAM_START_ADR + offset), data,
+					chunk);
+		}
+		if (status != DS1307_OK) {
+			break;
+		}
+		offset += (uint8_t) chunk;
+		data += chunk;
+		length -= (uint8_t) chunk;
+	}
+	ds1307_unlock(usr);
+	return status;
+}
+
+/**
+  * @brief  Enables or disables the DS1307 oscillator by setting the CH (Clock Halt) bit.
+  * @param  usr: Pointer to the DS1307 context structure.
+  * @param  clock: Clock state to set. This parameter can be one of the following values:
+  *         @arg DS1307_CLOCK_ENABLE:  Enables the oscillator (CH = 0)
+  *         @arg DS1307_CLOCK_DISABLE: Disables the oscillator (CH = 1)
+  * @retval Status of the first failing transfer, or @ref DS1307_OK.
+  * @note   Disabling the clock stops the timekeeping functions. This may be used to pause time updates during configuration.
+  *         The CH bit is located in bit 7 of the seconds register. The seconds register is read and written
+  *         back with only the CH bit changed, so the seconds count is kept. To set the time and start the
+  *         clock in one transfer use @ref ds1307_set_date_time_clock instead.
+  *         The bus lock is held for the whole operation.
+  */
+ds1307_status_t ds1307_set_ch(ds1307_context_t *usr, ds1307_clock_t clock) {
+	ds1307_status_t status;
+
+	ds1307_lock(usr);
+	status = ds1307_set_ch_locked(usr, clock);
+	ds1307_unlock(usr);
+	return status;
+}
+
+/**
+  * @brief  Read-modify-write of the CH bit, called with the bus lock held.
+  * @param  usr: Pointer to the DS1307 context structure.
+  * @param  clock: Clock state to set.
+  * @retval Same as @ref ds1307_set_ch.
+  */
+static ds1307_status_t ds1307_set_ch_locked(ds1307_context_t *usr,
+		ds1307_clock_t clock) {
+	uint8_t second = 0;
+	ds1307_status_t status = ds1307_i2c_read(usr, DS1307_READ_ADR,
+			DS1307_SEC_REG_ADR, &second, 1);
+
+	if (status != DS1307_OK) {
+		return status;
+	}
+	if (clock == DS1307_CLOCK_DISABLE) {
+		second |= (1U << 7);
+	} else {
+		second &= ~(1U << 7);
+	}
+	status = ds1307_i2c_send(usr, DS1307_WRITE_ADR, DS1307_SEC_REG_ADR,
+			&second, 1);
+	if (status == DS1307_OK) {
+		usr->regs[DS1307_SEC_REG_ADR] = second;
+		usr->decoded &= ~DS1307_FIELD_SECOND;
+	}
+	return status;
+}
+
+/**
+  * @brief  Reads the full date and time information from the DS1307 device and updates the context structure.
+  * @param  usr: Pointer to the DS1307 context structure where the date and time values will be stored.
+  * @retval Status of the transfer.
+  * @note   All seven timekeeping registers (0x00–0x06) are fetched in one auto-increment transfer.
+  *         The DS1307 latches its user buffers at the I2C START, so the returned values are
+  *         consistent and cannot tear when the seconds register rolls over mid-read. The guarantee
+  *         covers one transfer only: the per-field getters, and @ref ds1307_init when
+  *         max_transfer_size splits the time registers, can see a carry between their transfers.
+  *         The context is left unchanged if the transfer fails.
+  */
+ds1307_status_t DS1307_read_date_time(ds1307_context_t *usr) {
+	uint8_t regs[DS1307_TIME_REG_COUNT];
+	ds1307_status_t status = ds1307_i2c_read(usr, DS1307_READ_ADR,
+			DS1307_SEC_REG_ADR, regs, DS1307_TIME_REG_COUNT);
 
+	if (status == DS1307_OK) {
+		ds1307_decode_date_time(usr, regs);
+	}
+	return status;
+}
+
+/**
+  * @brief  Reads the DS1307 device state at startup.
+  * @param  usr: Pointer to the DS1307 context structure.
+  * @param  boot: Receives the device state (unchanged if the transfer fails).
+  * @retval Status of the transfer.
+  * @note   Registers 0x00–0x0A (time, control and the first DS1307_INIT_MAGIC_SIZE bytes of RAM) are
+  *         read in one burst, or in chunks of usr->functions.max_transfer_size bytes under the bus lock
+  *         when that is smaller. A limit below DS1307_TIME_REG_COUNT splits the time itself, which is
+  *         then only consistent if no seconds carry falls between the chunks. The state is:
+  *         - @ref DS1307_BOOT_POWER_LOST if the magic of the RAM marker written by @ref ds1307_init_mark
+  *           is missing, since the RAM is lost together with the time when the backup supply fails;
+  *         - @ref DS1307_BOOT_CORRUPT if the marker CRC does not match the control register and the
+  *           magic, or if a register is not valid BCD, is out of range, or has bits set that always
+  *           read 0;
+  *         - @ref DS1307_BOOT_HALTED if the CH bit is set;
+  *         - @ref DS1307_BOOT_VALID otherwise.
+  *         For VALID and HALTED the date, time and SQW configuration are decoded into the context, so
+  *         no further read is needed. usr->marked is set whenever the magic is present. The first
+  *         DS1307_INIT_MAGIC_SIZE bytes of RAM are reserved for the marker.
+  */
+ds1307_status_t ds1307_init(ds1307_context_t *usr, ds1307_boot_t *boot) {
+	uint8_t regs[DS1307_RAM_START_ADR + DS1307_INIT_MAGIC_SIZE];
+	uint16_t limit = usr->functions.max_transfer_size;
+	ds1307_status_t status = DS1307_OK;
+	uint8_t offset = 0;
+	uint8_t chunk;
+
+	ds1307_lock(usr);
+	while (offset < sizeof(regs) && status == DS1307_OK) {
+		chunk = (uint8_t) (sizeof(regs) - offset);
+		if (limit != 0 && chunk > limit) {
+			chunk = (uint8_t) limit;
+		}
+		status = ds1307_i2c_read(usr, DS1307_READ_ADR,
+				(ds1307_reg_adr_t) (DS1307_SEC_REG_ADR + offset), &regs[offset],
+				chunk);
+		offset += chunk;
+	}
+	ds1307_unlock(usr);
+	if (status != DS1307_OK) {
+		return status;
+	}
+
+	if (regs[DS1307_RAM_START_ADR] != (uint8_t) DS1307_INIT_MAGIC
+			|| regs[DS1307_RAM_START_ADR + 1U]
+					!= (uint8_t) (DS1307_INIT_MAGIC >> 8)) {
+		usr->marked = 0;
+		*boot = DS1307_BOOT_POWER_LOST;
+		return DS1307_OK;
+	}
+	usr->marked = 1;
+	if (regs[DS1307_RAM_START_ADR + 2U]
+			!= ds1307_crc8(&regs[DS1307_CONT_REG_ADR], 3U)
+			|| !ds1307_regs_valid(regs)) {
+		*boot = DS1307_BOOT_CORRUPT;
+		return DS1307_OK;
+	}
+
+	ds1307_decode_date_time(usr, regs);
+	usr->sqw = (ds1307_sqw_t) (regs[DS1307_CONT_REG_ADR] & 0x93);
+	*boot = (regs[DS1307_SEC_REG_ADR] & (1U << 7)) ?
+			DS1307_BOOT_HALTED : DS1307_BOOT_VALID;
+	return DS1307_OK;
+}
+
+/**
+  * @brief  Writes the RAM marker checked by @ref ds1307_init.
+  * @param  usr: Pointer to the DS1307 context structure.
+  * @retval Status of the transfer.
+  * @note   Call once a valid time has been set, e.g. after @ref ds1307_set_date_time following a
+  *         @ref DS1307_BOOT_POWER_LOST result. The control register is written with usr->sqw in the
+  *         same transfer, since the marker CRC covers it; @ref ds1307_set_sqw keeps the CRC up to
+  *         date afterwards.
+  */
+ds1307_status_t ds1307_init_mark(ds1307_context_t *usr) {
+	uint8_t buf[1U + DS1307_INIT_MAGIC_SIZE];
+	ds1307_status_t status;
+
+	buf[0] = (uint8_t) usr->sqw;
+	ds1307_init_marker(buf);
+	status = ds1307_i2c_send(usr, DS1307_WRITE_ADR, DS1307_CONT_REG_ADR, buf,
+			sizeof(buf));
+	if (status == DS1307_OK) {
+		usr->marked = 1;
+	}
+	return status;
+}
+
+/**
+  * @brief  Fills in the RAM marker that follows a control register value.
+  * @param  buf: Control register value, followed by room for the DS1307_INIT_MAGIC_SIZE marker bytes.
+  * @retval None
+  */
+static void ds1307_init_marker(uint8_t *buf) {
+	buf[1] = (uint8_t) DS1307_INIT_MAGIC;
+	buf[2] = (uint8_t) (DS1307_INIT_MAGIC >> 8);
+	buf[3] = ds1307_crc8(buf, 3U);
+}
+
+/**
+  * @brief  Checks the timekeeping and control registers for valid BCD values in range.
+  * @param  regs: Registers 0x00–0x07.
+  * @retval Non-zero if every register is valid.
+  * @note   The day of the month is only checked against 1–31, not against the month.
+  */
+static uint8_t ds1307_regs_valid(const uint8_t *regs) {
+	uint8_t hour = regs[DS1307_HOUR_REG_ADR];
+
+	if (hour & (1U << 7)) {
+		return 0;
+	}
+	if (hour & (1U << 6)) {
+		if (!DS1307_CONFIG_12H
+				|| !ds1307_bcd_in_range(hour & 0x1FU, 0x01U, 0x12U)) {
+			return 0;
+		}
+	} else if (!ds1307_bcd_in_range(hour, 0x00U, 0x23U)) {
+		return 0;
+	}
+	return ds1307_bcd_in_range(regs[DS1307_SEC_REG_ADR] & 0x7FU, 0x00U, 0x59U)
+			&& ds1307_bcd_in_range(regs[DS1307_MIN_REG_ADR], 0x00U, 0x59U)
+			&& ds1307_bcd_in_range(regs[DS1307_DAY_REG_ADR], 0x01U, 0x07U)
+			&& ds1307_bcd_in_range(regs[DS1307_DATE_REG_ADR], 0x01U, 0x31U)
+			&& ds1307_bcd_in_range(regs[DS1307_MONTH_REG_ADR], 0x01U, 0x12U)
+			&& ds1307_bcd_in_range(regs[DS1307_YEAR_REG_ADR], 0x00U, 0x99U)
+			&& !(regs[DS1307_CONT_REG_ADR] & 0x6CU);
+}
+
+/**
+  * @brief  Checks that a value is valid BCD and within a BCD range.
+  * @param  value: Value to check.
+  * @param  min: Smallest allowed value, BCD encoded.
+  * @param  max: Largest allowed value, BCD encoded.
+  * @retval Non-zero if both digits are 0–9 and min <= value <= max.
+  * @note   BCD values compare in the same order as their decimal values.
+  */
+static uint8_t ds1307_bcd_in_range(uint8_t value, uint8_t min, uint8_t max) {
+	return (value & 0x0FU) <= 9U && (value >> 4) <= 9U && value >= min
+			&& value <= max;
+}
+
+/**
+  * @brief  Reads the raw timekeeping registers from the DS1307 device without decoding them.
+  * @param  usr: Pointer to the DS1307 context structure where the raw image will be stored.
+  * @retval Status of the transfer.
+  * @note   All seven registers are fetched in one burst into usr->regs and the decoded bitmap is cleared.
+  *         The decoded fields are only brought up to date by the accessors (@ref ds1307_second,
+  *         @ref ds1307_minute, ...), each of which decodes its own field on first use. Loops that only
+  *         check one field therefore skip the BCD conversion of all others.
+  *         The raw image is left unchanged if the transfer fails.
+  */
+ds1307_status_t ds1307_read_raw(ds1307_context_t *usr) {
+	uint8_t regs[DS1307_TIME_REG_COUNT];
+	ds1307_status_t status = ds1307_i2c_read(usr, DS1307_READ_ADR,
+			DS1307_SEC_REG_ADR, regs, DS1307_TIME_REG_COUNT);
+	uint8_t i;
+
+	if (status != DS1307_OK) {
+		return status;
+	}
+	for (i = 0; i < DS1307_TIME_REG_COUNT; i++) {
+		usr->regs[i] = regs[i];
+	}
+	usr->decoded = 0;
+	return DS1307_OK;
+}
+
+/**
+  * @brief  Returns the second value from the raw register image.
+  * @param  usr: Pointer to the DS1307 context structure.
+  * @retval Second value (0–59). usr->second is updated when the field is decoded.
+  */
+uint8_t ds1307_second(ds1307_context_t *usr) {
+	if (!(usr->decoded & DS1307_FIELD_SECOND)) {
+		usr->second = BcdToDec(usr->regs[DS1307_SEC_REG_ADR] & ~(1U << 7));
+		usr->decoded |= DS1307_FIELD_SECOND;
+	}
+	return usr->second;
+}
+
+/**
+  * @brief  Returns the minute value from the raw register image.
+  * @param  usr: Pointer to the DS1307 context structure.
+  * @retval Minute value (0–59). usr->minute is updated when the field is decoded.
+  */
+uint8_t ds1307_minute(ds1307_context_t *usr) {
+	if (!(usr->decoded & DS1307_FIELD_MINUTE)) {
+		usr->minute = BcdToDec(usr->regs[DS1307_MIN_REG_ADR]);
+		usr->decoded |= DS1307_FIELD_MINUTE;
+	}
+	return usr->minute;
+}
+
+/**
+  * @brief  Returns the hour value from the raw register image.
+  * @param  usr: Pointer to the DS1307 context structure.
+  * @retval Hour value in the device format. usr->hour, usr->time_format and usr->time_period are
+  *         updated when the field is decoded.
+  */
+uint8_t ds1307_hour(ds1307_context_t *usr) {
+	if (!(usr->decoded & DS1307_FIELD_HOUR)) {
+		ds1307_decode_hour(usr, usr->regs[DS1307_HOUR_REG_ADR]);
+		usr->decoded |= DS1307_FIELD_HOUR;
+	}
+	return usr->hour;
+}
+
+/**
+  * @brief  Returns the day of the week from the raw register image.
+  * @param  usr: Pointer to the DS1307 context structure.
+  * @retval Day of the week (1 = Monday, ..., 7 = Sunday). usr->day is updated when the field is decoded.
+  */
+ds1307_day_t ds1307_day(ds1307_context_t *usr) {
+	if (!(usr->decoded & DS1307_FIELD_DAY)) {
+		usr->day = (ds1307_day_t) BcdToDec(usr->regs[DS1307_DAY_REG_ADR]);
+		usr->decoded |= DS1307_FIELD_DAY;
+	}
+	return usr->day;
+}
+
+/**
+  * @brief  Returns the date (day of the month) from the raw register image.
+  * @param  usr: Pointer to the DS1307 context structure.
+  * @retval Day of the month (1–31). usr->date is updated when the field is decoded.
+  */
+uint8_t ds1307_date(ds1307_context_t *usr) {
+	if (!(usr->decoded & DS1307_FIELD_DATE)) {
+		usr->date = BcdToDec(usr->regs[DS1307_DATE_REG_ADR]);
+		usr->decoded |= DS1307_FIELD_DATE;
+	}
+	return usr->date;
+}
+
+/**
+  * @brief  Returns the month from the raw register image.
+  * @param  usr: Pointer to the DS1307 context structure.
+  * @retval Month (1 = January, ..., 12 = December). usr->month is updated when the field is decoded.
+  */
+ds1307_month_t ds1307_month(ds1307_context_t *usr) {
+	if (!(usr->decoded & DS1307_FIELD_MONTH)) {
+		usr->month = (ds1307_month_t) BcdToDec(usr->regs[DS1307_MONTH_REG_ADR]);
+		usr->decoded |= DS1307_FIELD_MONTH;
+	}
+	return usr->month;
+}
+
+/**
+  * @brief  Returns the full year from the raw register image.
+  * @param  usr: Pointer to the DS1307 context structure.
+  * @retval Full 4-digit year, reconstructed with usr->century. usr->year is updated when the field is decoded.
+  */
+uint16_t ds1307_year(ds1307_context_t *usr) {
+	if (!(usr->decoded & DS1307_FIELD_YEAR)) {
+		usr->year = DS1307_CENTURY(usr)
+				+ ((uint16_t) BcdToDec(usr->regs[DS1307_YEAR_REG_ADR]));
+		usr->decoded |= DS1307_FIELD_YEAR;
+	}
+	return usr->year;
+}
+
+/**
+  * @brief  Decodes a raw timekeeping register image into the context structure.
+  * @param  usr: Pointer to the DS1307 context structure where the decoded values will be stored.
+  * @param  regs: Raw register image starting at @ref DS1307_SEC_REG_ADR (DS1307_TIME_REG_COUNT bytes).
+  * @retval None
+  * @note   The CH (Clock Halt) bit is masked out of the seconds value. The image is also kept in
+  *         usr->regs and all fields are marked as decoded.
+  */
+static void ds1307_decode_date_time(ds1307_context_t *usr, const uint8_t *regs) {
+	uint8_t dec[DS1307_TIME_REG_COUNT];
+	uint8_t i;
+
+	if (regs != usr->regs) {
+		for (i = 0; i < DS1307_TIME_REG_COUNT; i++) {
+			usr->regs[i] = regs[i];
+		}
+	}
+
+	for (i = 0; i < DS1307_TIME_REG_COUNT; i++) {
+		dec[i] = regs[i];
+	}
+	dec[DS1307_SEC_REG_ADR] &= ~(1U << 7);
+	ds1307_bcd_to_dec_image(dec);
+
+	usr->second = dec[DS1307_SEC_REG_ADR];
+	usr->minute = dec[DS1307_MIN_REG_ADR];
+	ds1307_decode_hour(usr, regs[DS1307_HOUR_REG_ADR]);
+	usr->day = (ds1307_day_t) dec[DS1307_DAY_REG_ADR];
+	usr->date = dec[DS1307_DATE_REG_ADR];
+	usr->month = (ds1307_month_t) dec[DS1307_MONTH_REG_ADR];
+	usr->year = DS1307_CENTURY(usr) + ((uint16_t) dec[DS1307_YEAR_REG_ADR]);
+	usr->decoded = DS1307_FIELD_ALL;
+}
+
+/**
+  * @brief  Starts a non-blocking burst read of the full date and time.
+  * @param  usr: Pointer to the DS1307 context structure where the date and time values will be stored.
+  * @param  done: Optional callback invoked once the transfer has finished (may be NULL).
+  * @retval @ref DS1307_OK if the transfer was started, @ref DS1307_BUSY if another asynchronous
+  *         operation is in progress, otherwise the status returned by the transport.
+  * @note   Requires usr->functions.ds1307_i2c_async_start_ptr. The call returns as soon as the
+  *         transfer has been started; the context is updated in @ref ds1307_async_complete.
+  *         The callback is not invoked when the transfer could not be started.
+  */
+ds1307_status_t ds1307_read_date_time_async(ds1307_context_t *usr,
+		ds1307_async_done_func_t done) {
+	if (usr->async_state != DS1307_ASYNC_IDLE) {
+		return DS1307_BUSY;
+	}
+	return ds1307_async_start(usr, DS1307_ASYNC_READ_DATE_TIME, done);
+}
+
+/**
+  * @brief  Starts a non-blocking burst write of the full date and time held in the context structure.
+  * @param  usr: Pointer to the DS1307 context structure holding the values to write.
+  * @param  done: Optional callback invoked once the transfer has finished (may be NULL).
+  * @retval Same as @ref ds1307_read_date_time_async.
+  * @note   The values are encoded as in @ref ds1307_set_date_time when the call is made, so the
+  *         context may be modified while the transfer is in flight.
+  */
+ds1307_status_t ds1307_set_date_time_async(ds1307_context_t *usr,
+		ds1307_async_done_func_t done) {
+	if (usr->async_state != DS1307_ASYNC_IDLE) {
+		return DS1307_BUSY;
+	}
+	ds1307_encode_date_time(usr, usr->async_buf);
+	return ds1307_async_start(usr, DS1307_ASYNC_WRITE_DATE_TIME, done);
+}
+
+/**
+  * @brief  Starts the asynchronous timekeeping transfer for the given operation.
+  * @param  usr: Pointer to the DS1307 context structure.
+  * @param  state: Operation to start (@ref DS1307_ASYNC_READ_DATE_TIME or @ref DS1307_ASYNC_WRITE_DATE_TIME).
+  * @param  done: Optional completion callback (may be NULL).
+  * @retval Status returned by the transport. The context returns to idle if the start fails.
+  */
+static ds1307_status_t ds1307_async_start(ds1307_context_t *usr,
+		ds1307_async_state_t state, ds1307_async_done_func_t done) {
+	ds1307_status_t status;
+
+	usr->async_state = state;
+	usr->async_done = done;
+	if (state == DS1307_ASYNC_READ_DATE_TIME) {
+		status = usr->functions.ds1307_i2c_async_start_ptr(
+				usr->functions.handle, DS1307_ASYNC_DIR_READ, DS1307_READ_ADR,
+				DS1307_SEC_REG_ADR, usr->async_buf, DS1307_TIME_REG_COUNT);
+	} else {
+		status = usr->functions.ds1307_i2c_async_start_ptr(
+				usr->functions.handle, DS1307_ASYNC_DIR_WRITE, DS1307_WRITE_ADR,
+				DS1307_SEC_REG_ADR, usr->async_buf, DS1307_TIME_REG_COUNT);
+	}
+	if (status != DS1307_OK) {
+		usr->async_state = DS1307_ASYNC_IDLE;
+		usr->async_done = 0;
+	}
+	return status;
+}
+
+/**
+  * @brief  Completes the asynchronous operation in progress.
+  * @param  usr: Pointer to the DS1307 context structure the operation was started on.
+  * @param  status: Result of the transfer as reported by the platform (@ref DS1307_OK on success).
+  * @retval None
+  * @note   Call this from the platform's transfer complete or error interrupt (or callback). Successful
+  *         read results are decoded into the context before the user completion callback is invoked;
+  *         the status is passed on to the callback unchanged.
+  */
+void ds1307_async_complete(ds1307_context_t *usr, ds1307_status_t status) {
+	ds1307_async_state_t state = usr->async_state;
+	ds1307_async_done_func_t done = usr->async_done;
+
+	if (state == DS1307_ASYNC_IDLE) {
+		return;
+	}
+	if (state == DS1307_ASYNC_READ_DATE_TIME && status == DS1307_OK) {
+		ds1307_decode_date_time(usr, usr->async_buf);
+	}
+	usr->async_state = DS1307_ASYNC_IDLE;
+	usr->async_done = 0;
+	if (done) {
+		done(usr, status);
+	}
+}
+
+/**
+  * @brief  Polls the asynchronous transport and completes the operation when its transfer has finished.
+  * @param  usr: Pointer to the DS1307 context structure.
+  * @retval @ref DS1307_BUSY while the transfer is in progress, otherwise the result it completed with
+  *         (@ref DS1307_OK when no operation is pending).
+  * @note   Intended for transports without a completion interrupt. Requires
+  *         usr->functions.ds1307_i2c_async_poll_ptr.
+  */
+ds1307_status_t ds1307_async_poll(ds1307_context_t *usr) {
+	ds1307_status_t status;
+
+	if (usr->async_state == DS1307_ASYNC_IDLE) {
+		return DS1307_OK;
+	}
+	status = usr->functions.ds1307_i2c_async_poll_ptr(usr->functions.handle);
+	if (status != DS1307_BUSY) {
+		ds1307_async_complete(usr, status);
+	}
+	return status;
+}
+
+/**
+  * @brief  Reports whether an asynchronous operation is in progress.
+  * @param  usr: Pointer to the DS1307 context structure.
+  * @retval Non-zero while an operation is in progress, zero when idle.
+  */
+uint8_t ds1307_async_busy(const ds1307_context_t *usr) {
+	return (usr->async_state != DS1307_ASYNC_IDLE);
+}
+
+/**
+  * @brief  Reads the full date and time from the DS1307 device into a compact timestamp.
+  * @param  usr: Pointer to the DS1307 context structure used for I2C access. Its date and time fields are not modified.
+  * @param  time: Pointer to the compact timestamp to fill.
+  * @retval Status of the transfer.
+  * @note   Only the raw registers are stored; no BCD conversion is made. The century is taken from usr->century.
+  *         The timestamp is left unchanged if the transfer fails.
+  */
+ds1307_status_t ds1307_compact_read(ds1307_context_t *usr,
+		ds1307_compact_t *time) {
+	uint8_t regs[DS1307_TIME_REG_COUNT];
+	ds1307_status_t status = ds1307_i2c_read(usr, DS1307_READ_ADR,
+			DS1307_SEC_REG_ADR, regs, DS1307_TIME_REG_COUNT);
+	uint8_t i;
+
+	if (status != DS1307_OK) {
+		return status;
+	}
+	for (i = 0; i < DS1307_TIME_REG_COUNT; i++) {
+		time->regs[i] = regs[i];
+	}
+	time->century = (uint8_t) (DS1307_CENTURY(usr) / 100U);
+	return DS1307_OK;
+}
+
+/**
+  * @brief  Writes a compact timestamp to the DS1307 device in a single burst.
+  * @param  usr: Pointer to the DS1307 context structure used for I2C access.
+  * @param  time: Pointer to the compact timestamp to write.
+  * @retval Status of the transfer.
+  * @note   usr->century is updated from the timestamp.
+  */
+ds1307_status_t ds1307_compact_write(ds1307_context_t *usr,
+		const ds1307_compact_t *time) {
+	uint8_t regs[DS1307_TIME_REG_COUNT];
+	uint8_t i;
+
+	for (i = 0; i < DS1307_TIME_REG_COUNT; i++) {
+		regs[i] = time->regs[i];
+	}
+#if DS1307_CONFIG_CENTURY
+	usr->century = (uint16_t) time->century * 100U;
+#endif
+	return ds1307_i2c_send(usr, DS1307_WRITE_ADR, DS1307_SEC_REG_ADR, regs,
+			DS1307_TIME_REG_COUNT);
+}
+
+/**
+  * @brief  Encodes the date and time held in the context structure into a compact timestamp.
+  * @param  usr: Pointer to the DS1307 context structure holding the values to encode.
+  * @param  time: Pointer to the compact timestamp to fill.
+  * @retval None
+  * @note   usr->hour is interpreted as for @ref ds1307_set_date_time.
+  */
+void ds1307_compact_pack(ds1307_context_t *usr, ds1307_compact_t *time) {
+	ds1307_encode_date_time(usr, time->regs);
+	time->century = (uint8_t) (DS1307_CENTURY(usr) / 100U);
+}
+
+/**
+  * @brief  Decodes a compact timestamp into the date and time fields of the context structure.
+  * @param  usr: Pointer to the DS1307 context structure to update.
+  * @param  time: Pointer to the compact timestamp to decode.
+  * @retval None
+  */
+void ds1307_compact_unpack(ds1307_context_t *usr, const ds1307_compact_t *time) {
+#if DS1307_CONFIG_CENTURY
+	usr->century = (uint16_t) time->century * 100U;
+#endif
+	ds1307_decode_date_time(usr, time->regs);
+}
+
+/**
+  * @brief  Publishes a compact timestamp to a snapshot.
+  * @param  snapshot: Pointer to the snapshot structure.
+  * @param  time: Pointer to the compact timestamp to publish.
+  * @retval None
+  * @note   Only one updater may publish to a snapshot at a time. The sequence counter is odd while the
+  *         timestamp is being copied, so readers can detect and discard a partial copy.
+  */
+void ds1307_snapshot_publish(ds1307_snapshot_t *snapshot,
+		const ds1307_compact_t *time) {
+	snapshot->seq++;
+	DS1307_BARRIER();
+	snapshot->time = *time;
+	DS1307_BARRIER();
+	snapshot->seq++;
+}
+
+/**
+  * @brief  Reads the full date and time from the DS1307 device and publishes it to a snapshot.
+  * @param  usr: Pointer to the DS1307 context structure used for I2C access.
+  * @param  snapshot: Pointer to the snapshot structure.
+  * @retval Status of the transfer. Nothing is published if it fails.
+  */
+ds1307_status_t ds1307_snapshot_update(ds1307_context_t *usr,
+		ds1307_snapshot_t *snapshot) {
+	ds1307_compact_t time;
+	ds1307_status_t status = ds1307_compact_read(usr, &time);
+
+	if (status == DS1307_OK) {
+		ds1307_snapshot_publish(snapshot, &time);
+	}
+	return status;
+}
+
+/**
+  * @brief  Copies the timestamp published to a snapshot.
+  * @param  snapshot: Pointer to the snapshot structure.
+  * @param  time: Pointer to the compact timestamp to fill.
+  * @retval @ref DS1307_OK if a consistent copy was made, @ref DS1307_BUSY if an update is in progress.
+  * @note   Lock-free and safe to call from interrupts. A copy that overlapped an update is retried. An
+  *         interrupt that preempted the updater gets @ref DS1307_BUSY instead of spinning, and can keep
+  *         its previous value.
+  */
+ds1307_status_t ds1307_snapshot_read(const ds1307_snapshot_t *snapshot,
+		ds1307_compact_t *time) {
+	uint32_t seq;
+
+	for (;;) {
+		seq = snapshot->seq;
+		if (seq & 1U) {
+			return DS1307_BUSY;
+		}
+		DS1307_BARRIER();
+		*time = snapshot->time;
+		DS1307_BARRIER();
+		if (snapshot->seq == seq) {
+			return DS1307_OK;
+		}
+	}
+}
+
+/**
+  * @brief  Decodes the second value of a compact timestamp.
+  * @param  time: Pointer to the compact timestamp.
+  * @retval Second value (0–59). The CH bit is masked out.
+  */
+uint8_t ds1307_compact_second(const ds1307_compact_t *time) {
+	return BcdToDec(time->regs[DS1307_SEC_REG_ADR] & ~(1U << 7));
+}
+
+/**
+  * @brief  Decodes the minute value of a compact timestamp.
+  * @param  time: Pointer to the compact timestamp.
+  * @retval Minute value (0–59).
+  */
+uint8_t ds1307_compact_minute(const ds1307_compact_t *time) {
+	return BcdToDec(time->regs[DS1307_MIN_REG_ADR]);
+}
+
+/**
+  * @brief  Decodes the hour value of a compact timestamp.
+  * @param  time: Pointer to the compact timestamp.
+  * @retval Hour value in 24-hour format (0–23), whatever format the device uses.
+  */
+uint8_t ds1307_compact_hour(const ds1307_compact_t *time) {
+	return ds1307_raw_hour_to_24(time->regs[DS1307_HOUR_REG_ADR]);
+}
+
+/**
+  * @brief  Decodes the day of the week of a compact timestamp.
+  * @param  time: Pointer to the compact timestamp.
+  * @retval Day of the week (1 = Monday, ..., 7 = Sunday).
+  */
+ds1307_day_t ds1307_compact_day(const ds1307_compact_t *time) {
+	return (ds1307_day_t) BcdToDec(time->regs[DS1307_DAY_REG_ADR]);
+}
+
+/**
+  * @brief  Decodes the date (day of the month) of a compact timestamp.
+  * @param  time: Pointer to the compact timestamp.
+  * @retval Day of the month (1–31).
+  */
+uint8_t ds1307_compact_date(const ds1307_compact_t *time) {
+	return BcdToDec(time->regs[DS1307_DATE_REG_ADR]);
+}
+
+/**
+  * @brief  Decodes the month of a compact timestamp.
+  * @param  time: Pointer to the compact timestamp.
+  * @retval Month (1 = January, ..., 12 = December).
+  */
+ds1307_month_t ds1307_compact_month(const ds1307_compact_t *time) {
+	return (ds1307_month_t) BcdToDec(time->regs[DS1307_MONTH_REG_ADR]);
+}
+
+/**
+  * @brief  Decodes the full year of a compact timestamp.
+  * @param  time: Pointer to the compact timestamp.
+  * @retval Full 4-digit year (e.g., 2025).
+  */
+uint16_t ds1307_compact_year(const ds1307_compact_t *time) {
+	return (uint16_t) time->century * 100U + BcdToDec(time->regs[DS1307_YEAR_REG_ADR]);
+}
+
+/**
+  * @brief  Advances the date and time held in the context structure by a number of seconds.
+  * @param  usr: Pointer to the DS1307 context structure to update.
+  * @param  seconds: Number of seconds to add.
+  * @retval None
+  * @note   No I2C transfer is made. Minutes, hours, day of the week, date, month, year and century
+  *         are carried according to the Gregorian calendar. In 12-hour format usr->hour and
+  *         usr->time_period are kept in 12-hour notation. Fields still pending after
+  *         @ref ds1307_read_raw are decoded first, so the hour format of the device is kept;
+  *         usr->regs then holds the new time as for @ref ds1307_from_epoch.
+  */
+void ds1307_add_seconds(ds1307_context_t *usr, uint32_t seconds) {
+	ds1307_decode_fields(usr);
+	ds1307_from_epoch(usr, ds1307_to_epoch(usr) + seconds);
+}
+
+/**
+  * @brief  Advances the date and time held in the context structure by one second.
+  * @param  usr: Pointer to the DS1307 context structure to update.
+  * @retval None
+  * @note   Intended to be called from the edge interrupt of the SQW/OUT pin configured with
+  *         @ref DS1307_SQW_1HZ, once per period. The context is first loaded with
+  *         @ref DS1307_read_date_time; afterwards it follows the device without any I2C traffic.
+  *         The call is short enough for interrupt context.
+  * @see    ds1307_set_sqw
+  */
+void ds1307_tick(ds1307_context_t *usr) {
+	ds1307_add_seconds(usr, 1);
+}
+
+/**
+  * @brief  Converts the date and time held in the context structure to a Unix timestamp.
+  * @param  usr: Pointer to the DS1307 context structure holding the date and time.
+  * @retval Seconds elapsed since 1970-01-01 00:00:00.
+  * @note   Valid for years 1970 to 2105. The hour is interpreted according to usr->time_format and
+  *         usr->time_period. Subtract @ref DS1307_EPOCH_2000 to obtain seconds since 2000-01-01.
+  *         Fields not yet decoded from usr->regs (see @ref ds1307_read_raw) are read through the
+  *         accessors on a local copy, so the context itself is not modified.
+  */
+uint32_t ds1307_to_epoch(const ds1307_context_t *usr) {
+	static const uint16_t days_before_month[12] = { 0, 31, 59, 90, 120, 151,
+			181, 212, 243, 273, 304, 334 };
+	ds1307_context_t view;
+	uint32_t y;
+	uint32_t m;
+	uint32_t days;
+
+	if (usr->decoded != DS1307_FIELD_ALL) {
+		view = *usr;
+		ds1307_decode_fields(&view);
+		usr = &view;
+	}
+	y = usr->year;
+	m = (uint32_t) usr->month;
+
+	/* Leap days up to the end of the previous year; 477 is that count for 1969. */
+	days = (y - 1970U) * 365U + ((y - 1U) / 4U - (y - 1U) / 100U + (y - 1U) / 400U)
+			- 477U;
+	days += days_before_month[m - 1U] + (uint32_t) usr->date - 1U;
+	days += (m > 2U && (y % 4U == 0U && (y % 100U != 0U || y % 400U == 0U)));
+
+	return ((days * 24U + ds1307_hour_to_24(usr)) * 60U + usr->minute) * 60U
+			+ usr->second;
+}
+
+/**
+  * @brief  Loads a Unix timestamp into the date and time fields of the context structure.
+  * @param  usr: Pointer to the DS1307 context structure to update.
+  * @param  epoch: Seconds elapsed since 1970-01-01 00:00:00.
+  * @retval None
+  * @note   No I2C transfer is made. All date and time fields, including the day of the week and the
+  *         century, are updated. The hour is stored according to usr->time_format.
+  *         usr->regs is re-encoded from the new fields, keeping the CH bit, and all fields are
+  *         marked as decoded, so the raw image, the accessors and the formatters follow the new time.
+  *         The date is computed with a closed-form civil calendar algorithm, without loops
+  *         over years or months.
+  */
+void ds1307_from_epoch(ds1307_context_t *usr, uint32_t epoch) {
+	uint32_t days = epoch / 86400U;
+	uint32_t rem = epoch % 86400U;
+	uint32_t z = days + 719468U; /* days since 0000-03-01 */
+	uint32_t era = z / 146097U;
+	uint32_t doe = z - era * 146097U;
+	uint32_t yoe = (doe - doe / 1460U + doe / 36524U - doe / 146096U) / 365U;
+	uint32_t doy = doe - (365U * yoe + yoe / 4U - yoe / 100U);
+	uint32_t mp = (5U * doy + 2U) / 153U;
+	uint32_t month = (mp < 10U) ? mp + 3U : mp - 9U;
+	uint32_t year = yoe + era * 400U + (month <= 2U);
+	uint8_t ch;
+
+	usr->date = (uint8_t) (doy - (153U * mp + 2U) / 5U + 1U);
+	usr->month = (ds1307_month_t) month;
+	usr->year = (uint16_t) year;
+#if DS1307_CONFIG_CENTURY
+	usr->century = (uint16_t) (year - year % 100U);
+#endif
+	usr->day = (ds1307_day_t) ((days + 3U) % 7U + 1U); /* 1970-01-01 was a Thursday */
+
+	usr->second = (uint8_t) (rem % 60U);
+	rem /= 60U;
+	usr->minute = (uint8_t) (rem % 60U);
+	ds1307_hour_from_24(usr, (uint8_t) (rem / 60U));
+
+	ch = usr->regs[DS1307_SEC_REG_ADR] & (1U << 7);
+	ds1307_encode_date_time(usr, usr->regs);
+	usr->regs[DS1307_SEC_REG_ADR] |= ch;
+	usr->decoded = DS1307_FIELD_ALL;
+}
+
+/**
+  * @brief  Decodes every date and time field still pending in the decoded bitmap.
+  * @param  usr: Pointer to the DS1307 context structure.
+  * @retval None
+  */
+static void ds1307_decode_fields(ds1307_context_t *usr) {
+	if (usr->decoded != DS1307_FIELD_ALL) {
+		ds1307_second(usr);
+		ds1307_minute(usr);
+		ds1307_hour(usr);
+		ds1307_day(usr);
+		ds1307_date(usr);
+		ds1307_month(usr);
+		ds1307_year(usr);
+	}
+}
+
+/**
+  * @brief  Returns the hour held in the context structure in 24-hour notation.
+  * @param  usr: Pointer to the DS1307 context structure.
+  * @retval Hour value (0–23).
+  */
+static uint8_t ds1307_hour_to_24(const ds1307_context_t *usr) {
+	uint8_t hour = usr->hour;
+
+	if (DS1307_CONFIG_12H && usr->time_format == DS1307_HOUR_FORMAT_12) {
+		if (hour == 12) {
+			hour = 0;
+		}
+		if (usr->time_period == DS1307_PM) {
+			hour += 12;
+		}
+	}
+	return hour;
+}
+
+/**
+  * @brief  Converts a raw hour register value to a 24-hour value.
+  * @param  hour: Raw hour register content, in either 12-hour or 24-hour layout.
+  * @retval Hour value (0–23).
+  */
+static uint8_t ds1307_raw_hour_to_24(uint8_t hour) {
+	uint8_t value;
+
+	if (DS1307_CONFIG_12H && (hour & (1U << 6))) {
+		value = BcdToDec(hour & 0x1F);
+		if (value == 12) {
+			value = 0;
+		}
+		if (hour & (1U << 5)) {
+			value += 12;
+		}
+		return value;
+	}
+	return BcdToDec(hour & 0x3F);
+}
+
+/**
+  * @brief  Stores a 24-hour value into the context structure according to usr->time_format.
+  * @param  usr: Pointer to the DS1307 context structure.
+  * @param  hour: Hour value in 24-hour format (0–23).
+  * @retval None
+  * @note   In 12-hour format usr->hour is set to 1–12 and usr->time_period to AM or PM.
+  *         In 24-hour format usr->time_period is set to DS1307_NONE, as when the register is decoded.
+  */
+static void ds1307_hour_from_24(ds1307_context_t *usr, uint8_t hour) {
+	if (DS1307_CONFIG_12H && usr->time_format == DS1307_HOUR_FORMAT_12) {
+		usr->time_period = (hour > 11) ? DS1307_PM : DS1307_AM;
+		hour %= 12;
+		if (hour == 0) {
+			hour = 12;
+		}
+	} else {
+		usr->time_period = DS1307_NONE;
+	}
+	usr->hour = hour;
+}
+
+#if (DS1307_CONFIG_CODEC == DS1307_CODEC_LUT)
+/**
+  * @brief  Decimal to BCD lookup table for values 0 to 99.
+  */
+static const uint8_t ds1307_dec_to_bcd_lut[100] = {
+		0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09,
+		0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19,
+		0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27, 0x28, 0x29,
+		0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39,
+		0x40, 0x41, 0x42, 0x43, 0x44, 0x45, 0x46, 0x47, 0x48, 0x49,
+		0x50, 0x51, 0x52, 0x53, 0x54, 0x55, 0x56, 0x57, 0x58, 0x59,
+		0x60, 0x61, 0x62, 0x63, 0x64, 0x65, 0x66, 0x67, 0x68, 0x69,
+		0x70, 0x71, 0x72, 0x73, 0x74, 0x75, 0x76, 0x77, 0x78, 0x79,
+		0x80, 0x81, 0x82, 0x83, 0x84, 0x85, 0x86, 0x87, 0x88, 0x89,
+		0x90, 0x91, 0x92, 0x93, 0x94, 0x95, 0x96, 0x97, 0x98, 0x99
+};
+#endif
+
+/**
+  * @brief  Converts a BCD (Binary-Coded Decimal) value to decimal.
+  * @param  value: 8-bit BCD value to convert.
+  * @retval Decimal representation of the input BCD value.
+  * @note   Apart from the default arithmetic backend, the conversion uses the identity
+  *         dec = bcd - 6 * (bcd >> 4), which needs neither a division nor a table.
+  */
+static uint8_t BcdToDec(uint8_t value) {
+
+#if (DS1307_CONFIG_CODEC == DS1307_CODEC_ARITH)
+	return ((((value & 0xf0) >> 4) * 10) + (value & 0x0f));
+#else
+	return (uint8_t) (value - 6U * (value >> 4));
+#endif
+
+}
+
+/**
+  * @brief  Converts a decimal value to BCD (Binary-Coded Decimal) format.
+  * @param  value: 8-bit decimal value to convert (0 to 99).
+  * @retval BCD representation of the input decimal value.
+  * @note   The LUT backend returns 0 for values above 99. The multiply-shift backends compute
+  *         value / 10 as (value * 205) >> 11, which is exact for every 8-bit input.
+  */
+static uint8_t DecToBcd(uint8_t value) {
+
+#if (DS1307_CONFIG_CODEC == DS1307_CODEC_ARITH)
+	return (((value / 10) << 4) + (value % 10));
+#elif (DS1307_CONFIG_CODEC == DS1307_CODEC_LUT)
+	return (value < 100U) ? ds1307_dec_to_bcd_lut[value] : 0U;
+#else
+	return (uint8_t) (value + 6U * (((uint16_t) value * 205U) >> 11));
+#endif
+
+}
+
+/**
+  * @brief  Converts a timekeeping register image from BCD to decimal in place.
+  * @param  data: Buffer of DS1307_TIME_REG_COUNT BCD bytes (flag bits must already be masked out).
+  * @retval None
+  * @note   With the SWAR backend four bytes are converted per 32-bit operation using
+  *         dec = bcd - 6 * ((bcd >> 4) & 0x0F): the per-byte subtraction can never borrow
+  *         across lanes because every BCD byte is at least 16 times its high nibble.
+  */
+static void ds1307_bcd_to_dec_image(uint8_t *data) {
+	uint8_t i;
+
+#if (DS1307_CONFIG_CODEC == DS1307_CODEC_SWAR)
+	uint32_t word;
+	uint8_t j;
+
+	for (i = 0; i < DS1307_TIME_REG_COUNT; i += 4U) {
+		word = 0;
+		for (j = 0; j < 4U && (i + j) < DS1307_TIME_REG_COUNT; j++) {
+			word |= (uint32_t) data[i + j] << (8U * j);
+		}
+		word -= 6U * ((word >> 4) & 0x0F0F0F0FUL);
+		for (j = 0; j < 4U && (i + j) < DS1307_TIME_REG_COUNT; j++) {
+			data[i + j] = (uint8_t) (word >> (8U * j));
+		}
+	}
+#else
+	for (i = 0; i < DS1307_TIME_REG_COUNT; i++) {
+		data[i] = BcdToDec(data[i]);
+	}
+#endif
+}
+
+/**
+  * @brief  Converts a timekeeping register image from decimal to BCD in place.
+  * @param  data: Buffer of DS1307_TIME_REG_COUNT decimal bytes (0 to 99 each).
+  * @retval None
+  * @note   With the SWAR backend two bytes are converted per 32-bit operation by placing them in
+  *         16-bit lanes, so that the (value * 205) >> 11 reciprocal cannot overflow into the next lane.
+  */
+static void ds1307_dec_to_bcd_image(uint8_t *data) {
+	uint8_t i;
+
+#if (DS1307_CONFIG_CODEC == DS1307_CODEC_SWAR)
+	uint32_t word;
+	uint32_t tens;
+
+	for (i = 0; i < DS1307_TIME_REG_COUNT; i += 2U) {
+		word = data[i];
+		if ((i + 1U) < DS1307_TIME_REG_COUNT) {
+			word |= (uint32_t) data[i + 1U] << 16;
+		}
+		tens = ((word * 205U) >> 11) & 0x000F000FUL;
+		word += 6U * tens;
+		data[i] = (uint8_t) word;
+		if ((i + 1U) < DS1307_TIME_REG_COUNT) {
+			data[i + 1U] = (uint8_t) (word >> 16);
+		}
+	}
+#else
+	for (i = 0; i < DS1307_TIME_REG_COUNT; i++) {
+		data[i] = DecToBcd(data[i]);
+	}
+#endif
 }
@@ -21,6 +21,12 @@
 
 #include <stdint.h>
 
+#include "DS1307_config.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
 /**
  * @brief  DS1307 I2C address definitions.
  */
@@ -41,9 +47,44 @@ typedef enum {
 	DS1307_DATE_REG_ADR, /*!< Day of the month register */
 	DS1307_MONTH_REG_ADR, /*!< Month register */
 	DS1307_YEAR_REG_ADR, /*!< Year register */
-	DS1307_CONT_REG_ADR /*!< Control register */
+	DS1307_CONT_REG_ADR, /*!< Control register */
+	DS1307_RAM_START_ADR /*!< First byte of the battery-backed RAM (0x08–0x3F) */
 } ds1307_reg_adr_t;
 
+/**
+ * @brief  Size of the battery-backed RAM in bytes.
+ */
+#define DS1307_RAM_SIZE		56U
+
+/**
+ * @brief  Validity marker kept by @ref ds1307_init_mark in the first DS1307_INIT_MAGIC_SIZE bytes of the RAM:
+ *         DS1307_INIT_MAGIC (low byte first) and a CRC-8 over the control register and the magic.
+ */
+#define DS1307_INIT_MAGIC		0x1307U
+#define DS1307_INIT_MAGIC_SIZE	3U
+
+/**
+ * @brief  Number of timekeeping registers (0x00–0x06) covered by a burst transfer.
+ */
+#define DS1307_TIME_REG_COUNT	7U
+
+/**
+ * @brief  Field bits of the timekeeping register image (bit n = register n).
+ */
+#define DS1307_FIELD_SECOND		(1U << DS1307_SEC_REG_ADR)
+#define DS1307_FIELD_MINUTE		(1U << DS1307_MIN_REG_ADR)
+#define DS1307_FIELD_HOUR		(1U << DS1307_HOUR_REG_ADR)
+#define DS1307_FIELD_DAY		(1U << DS1307_DAY_REG_ADR)
+#define DS1307_FIELD_DATE		(1U << DS1307_DATE_REG_ADR)
+#define DS1307_FIELD_MONTH		(1U << DS1307_MONTH_REG_ADR)
+#define DS1307_FIELD_YEAR		(1U << DS1307_YEAR_REG_ADR)
+#define DS1307_FIELD_ALL		((1U << DS1307_TIME_REG_COUNT) - 1U)
+
+/**
+ * @brief  Unix timestamp of 2000-01-01 00:00:00, for conversion to seconds since 2000.
+ */
+#define DS1307_EPOCH_2000	946684800UL
+
 /**
  * @brief  DS1307 clock control enumeration for CH (Clock Halt) bit.
  */
@@ -52,6 +93,26 @@ typedef enum {
 	DS1307_CLOCK_DISABLE /*!< Disable clock (CH = 1) */
 } ds1307_clock_t;
 
+/**
+ * @brief  SQW/OUT pin configuration, encoded as the control register value.
+ */
+typedef enum {
+	DS1307_SQW_OUT_LOW = 0x00, /*!< Square wave disabled, static low level (OUT = 0) */
+	DS1307_SQW_OUT_HIGH = 0x80, /*!< Square wave disabled, static high level (OUT = 1) */
+	DS1307_SQW_1HZ = 0x10, /*!< 1 Hz square wave (SQWE = 1, RS = 00) */
+	DS1307_SQW_4096HZ = 0x11, /*!< 4.096 kHz square wave (SQWE = 1, RS = 01) */
+	DS1307_SQW_8192HZ = 0x12, /*!< 8.192 kHz square wave (SQWE = 1, RS = 10) */
+	DS1307_SQW_32768HZ = 0x13 /*!< 32.768 kHz square wave (SQWE = 1, RS = 11) */
+} ds1307_sqw_t;
+
+/**
+ * @brief  Write mode of the ds1307_set_* functions.
+ */
+typedef enum {
+	DS1307_WRITE_IMMEDIATE, /*!< Every setter writes its register right away */
+	DS1307_WRITE_DEFERRED /*!< Setters mark fields dirty; @ref ds1307_commit writes them in one transfer */
+} ds1307_write_mode_t;
+
 /**
  * @brief  Enumeration for days of the week (1 = Monday, 7 = Sunday).
  */
@@ -100,33 +161,148 @@ typedef enum {
 	DS1307_HOUR_FORMAT_12 /*!< 12-hour format */
 } ds_1307_hour_format_t;
 
+/**
+ * @brief  Status codes returned by the driver API and by the user transport functions.
+ */
+typedef enum {
+	DS1307_OK = 0, /*!< Operation completed successfully */
+	DS1307_ERROR, /*!< Bus or device error (e.g. NACK, arbitration lost) */
+	DS1307_BUSY, /*!< Bus or driver busy, the operation was not started */
+	DS1307_TIMEOUT, /*!< Transfer did not complete in time */
+	DS1307_INVALID_PARAM, /*!< Invalid argument, never retried */
+	DS1307_INVALID_DATA /*!< Data read back failed validation */
+} ds1307_status_t;
+
+/**
+ * @brief  State of the device found by @ref ds1307_init.
+ */
+typedef enum {
+	DS1307_BOOT_VALID, /*!< Clock running, registers in range, RAM marker present */
+	DS1307_BOOT_HALTED, /*!< Registers in range but the oscillator is stopped (CH = 1) */
+	DS1307_BOOT_POWER_LOST, /*!< RAM marker missing: backup supply lost or device never initialized */
+	DS1307_BOOT_CORRUPT /*!< RAM marker present but its CRC or a register holds an invalid value */
+} ds1307_boot_t;
+
 /**
  * @brief  Function pointer type for I2C memory write operation.
+ * @param  handle: User-defined bus handle taken from @ref ds1307_user_func_t (may be NULL).
  * @param  address: I2C address of the DS1307 device.
  * @param  reg_adr: Register address within the DS1307 device.
  * @param  ds1307_data: Pointer to the data buffer to write.
  * @param  size: Number of bytes to write.
- * @retval None
+ * @retval @ref DS1307_OK on success, otherwise the error to report (see @ref ds1307_status_t).
  */
-typedef void (*ds1307_i2c_mem_write_func_t)(ds1307_adr_t address,
-		ds1307_reg_adr_t reg_adr, uint8_t *ds1307_data, uint16_t size);
+typedef ds1307_status_t (*ds1307_i2c_mem_write_func_t)(void *handle,
+		ds1307_adr_t address, ds1307_reg_adr_t reg_adr, uint8_t *ds1307_data,
+		uint16_t size);
 
 /**
  * @brief  Function pointer type for I2C memory read operation.
+ * @param  handle: User-defined bus handle taken from @ref ds1307_user_func_t (may be NULL).
  * @param  address: I2C address of the DS1307 device.
  * @param  reg_adr: Register address within the DS1307 device.
  * @param  ds1307_data: Pointer to the buffer to store received data.
  * @param  size: Number of bytes to read.
+ * @retval @ref DS1307_OK on success, otherwise the error to report (see @ref ds1307_status_t).
+ */
+typedef ds1307_status_t (*ds1307_i2c_mem_read_func_t)(void *handle,
+		ds1307_adr_t address, ds1307_reg_adr_t reg_adr, uint8_t *ds1307_data,
+		uint16_t size);
+
+/**
+ * @brief  Transfer direction passed to the asynchronous I2C start function.
+ */
+typedef enum {
+	DS1307_ASYNC_DIR_WRITE, /*!< Memory write transfer */
+	DS1307_ASYNC_DIR_READ /*!< Memory read transfer */
+} ds1307_async_dir_t;
+
+/**
+ * @brief  State of the asynchronous transfer state machine.
+ */
+typedef enum {
+	DS1307_ASYNC_IDLE, /*!< No transfer in progress */
+	DS1307_ASYNC_READ_DATE_TIME, /*!< Burst read of the timekeeping registers in progress */
+	DS1307_ASYNC_WRITE_DATE_TIME /*!< Burst write of the timekeeping registers in progress */
+} ds1307_async_state_t;
+
+/**
+ * @brief  Function pointer type for starting a non-blocking I2C memory transfer.
+ * @param  handle: User-defined bus handle taken from @ref ds1307_user_func_t (may be NULL).
+ * @param  dir: Transfer direction (read or write).
+ * @param  address: I2C address of the DS1307 device.
+ * @param  reg_adr: Register address within the DS1307 device.
+ * @param  ds1307_data: Pointer to the data buffer. It stays valid until the transfer completes.
+ * @param  size: Number of bytes to transfer.
+ * @retval @ref DS1307_OK if the transfer was started, otherwise the error to report.
+ * @note   The function must only start the transfer (e.g. DMA or interrupt driven) and return.
+ *         Completion is reported to the driver through @ref ds1307_async_complete or detected
+ *         through the optional poll function.
+ */
+typedef ds1307_status_t (*ds1307_i2c_async_start_func_t)(void *handle,
+		ds1307_async_dir_t dir, ds1307_adr_t address, ds1307_reg_adr_t reg_adr,
+		uint8_t *ds1307_data, uint16_t size);
+
+/**
+ * @brief  Function pointer type for polling the state of a non-blocking I2C transfer.
+ * @param  handle: User-defined bus handle taken from @ref ds1307_user_func_t (may be NULL).
+ * @retval @ref DS1307_BUSY while the transfer started last is in progress, otherwise its result.
+ */
+typedef ds1307_status_t (*ds1307_i2c_async_poll_func_t)(void *handle);
+
+/**
+ * @brief  Function pointer type for a blocking delay used between transfer retries.
+ * @param  ms: Delay in milliseconds.
  * @retval None
  */
-typedef void (*ds1307_i2c_mem_read_func_t)(ds1307_adr_t address,
-		ds1307_reg_adr_t reg_adr, uint8_t *ds1307_data, uint16_t size);
+typedef void (*ds1307_delay_func_t)(uint32_t ms);
 
 /**
- * @brief  Structure holding user-provided function pointers for I2C communication.
- * @note   These function pointers must be assigned to valid platform-specific
- *         I2C read and write implementations before using the driver.
+ * @brief  Function pointer type for taking or releasing the bus lock.
+ * @param  handle: User-defined bus handle taken from @ref ds1307_user_func_t (may be NULL).
+ * @retval None
+ * @note   The lock must be recursive (e.g. a FreeRTOS recursive mutex), because operations made of
+ *         several transfers hold it while every single transfer takes it again.
  */
+typedef void (*ds1307_lock_func_t)(void *handle);
+
+#if DS1307_CONFIG_STATS
+/**
+ * @brief  Function pointer type for reading a free-running cycle (or timer) counter.
+ * @retval Current counter value (wrap-around is handled).
+ */
+typedef uint32_t (*ds1307_cycle_func_t)(void);
+
+/**
+ * @brief  Number of statistics slots: one per register 0x00–0x07, plus one shared by the NVRAM.
+ */
+#define DS1307_STATS_SLOT_COUNT		9U
+
+/**
+ * @brief  Bus usage counters of transfers starting at one register.
+ */
+typedef struct {
+	uint32_t transactions; /*!< Transport calls, including retries */
+	uint32_t bytes; /*!< Bytes carried by those calls */
+	uint32_t retries; /*!< Transport calls that were retries of a failed attempt */
+} ds1307_reg_stats_t;
+
+/**
+ * @brief  Bus usage statistics of a context.
+ * @note   Transfers are accounted to the slot of their start register; all NVRAM transfers share
+ *         the last slot. Latency is measured in ticks of usr->functions.cycles around every
+ *         blocking transport call and is only recorded when that function is set.
+ */
+typedef struct {
+	ds1307_reg_stats_t reg[DS1307_STATS_SLOT_COUNT]; /*!< Counters per start register */
+	uint32_t errors; /*!< Transfers that still failed after all retries */
+	uint32_t latency_min; /*!< Shortest transport call */
+	uint32_t latency_max; /*!< Longest transport call */
+	uint64_t latency_sum; /*!< Sum of all measured transport calls */
+	uint32_t latency_count; /*!< Number of measured transport calls */
+} ds1307_stats_t;
+#endif
+
 /**
  * @brief  Structure holding user-provided function pointers for I2C communication.
  * @note   These function pointers must be assigned to valid platform-specific
@@ -135,8 +311,60 @@ typedef void (*ds1307_i2c_mem_read_func_t)(ds1307_adr_t address,
 typedef struct {
 	ds1307_i2c_mem_write_func_t ds1307_i2c_send_ptr; /*!< Pointer to I2C write function */
 	ds1307_i2c_mem_read_func_t ds1307_i2c_read_ptr; /*!< Pointer to I2C read function */
+	ds1307_i2c_async_start_func_t ds1307_i2c_async_start_ptr; /*!< Optional pointer to non-blocking I2C start function */
+	ds1307_i2c_async_poll_func_t ds1307_i2c_async_poll_ptr; /*!< Optional pointer to non-blocking I2C poll function */
+	void *handle; /*!< User-defined bus handle or user data passed to every transport call (may be NULL) */
+	uint16_t max_transfer_size; /*!< Largest transfer the transport supports in bytes (0 = no limit) */
+	uint8_t retries; /*!< Number of times a failed blocking transfer is repeated (0 = no retry) */
+	uint16_t retry_delay_ms; /*!< Delay before the first retry, doubled for every further retry */
+	ds1307_delay_func_t delay_ms; /*!< Optional pointer to a blocking delay function used between retries */
+	ds1307_lock_func_t lock; /*!< Optional pointer to a recursive bus lock function */
+	ds1307_lock_func_t unlock; /*!< Optional pointer to the matching bus unlock function */
+#if DS1307_CONFIG_STATS
+	ds1307_cycle_func_t cycles; /*!< Optional pointer to a cycle counter used for latency statistics */
+#endif
 } ds1307_user_func_t;
 
+typedef struct ds1307_context ds1307_context_t;
+
+/**
+ * @brief  Compact date/time representation holding the raw BCD register image.
+ * @note   Fields are decoded on access through the ds1307_compact_* accessors, so a timestamp
+ *         takes 8 bytes of RAM instead of a full @ref ds1307_context_t. Many compact timestamps
+ *         can share one context for I2C access, as in the device table of DS1307_mux.
+ */
+typedef struct {
+	uint8_t regs[DS1307_TIME_REG_COUNT]; /*!< Raw timekeeping registers 0x00–0x06 as read from the device */
+	uint8_t century; /*!< Century in units of 100 years (e.g., 20 for 2000) */
+} ds1307_compact_t;
+
+/**
+ * @brief  Compile-time check of the compact layout size (fails to compile if padding is added).
+ */
+typedef char ds1307_compact_size_check_t[(sizeof(ds1307_compact_t) == 8U) ? 1 : -1];
+
+/**
+ * @brief  Compact timestamp published through a sequence lock.
+ * @note   One updater writes it with @ref ds1307_snapshot_publish (or @ref ds1307_snapshot_update);
+ *         any number of tasks and interrupts read it with @ref ds1307_snapshot_read without locking.
+ *         The sequence lock only protects the copy between tasks; the published time is consistent
+ *         across a seconds rollover because it comes from one burst read.
+ *         Must be zero-initialized before first use.
+ */
+typedef struct {
+	volatile uint32_t seq; /*!< Sequence counter, odd while an update is in progress */
+	ds1307_compact_t time; /*!< Published timestamp */
+} ds1307_snapshot_t;
+
+/**
+ * @brief  Function pointer type for the completion callback of an asynchronous operation.
+ * @param  usr: Pointer to the DS1307 context structure the operation was started on.
+ * @param  status: Result of the transfer.
+ * @retval None
+ */
+typedef void (*ds1307_async_done_func_t)(ds1307_context_t *usr,
+		ds1307_status_t status);
+
 /**
  * @brief  DS1307 context structure containing time data and I2C function pointers.
  * @note   This structure serves as the main interface between the user application
@@ -144,7 +372,7 @@ typedef struct {
  *         user-provided I2C function pointers required for communication.
  * @see    ds1307_user_func_t
  */
-typedef struct {
+struct ds1307_context {
 	ds1307_user_func_t functions; /*!< User-defined I2C read/write function pointers */
 	ds1307_day_t day; /*!< Day of the week (1 = Monday, 7 = Sunday) */
 	ds1307_month_t month; /*!< Month of the year (1 = January, 12 = December) */
@@ -155,114 +383,401 @@ typedef struct {
 	uint8_t date; /*!< Day of the month (1–31) */
 	ds1307_timeperiod_t time_period; /*!< Time period indicator (AM, PM, or NONE for 24H mode) */
 	ds_1307_hour_format_t time_format; /*!< Hour format: 12-hour or 24-hour */
+#if DS1307_CONFIG_CENTURY
 	uint16_t century; /*!< Century offset (e.g., 2000 or 2100) for full year reconstruction */
-} ds1307_context_t;
+#endif
+	ds1307_sqw_t sqw; /*!< SQW/OUT pin configuration (control register) */
+	uint8_t marked; /*!< Non-zero once the RAM marker of @ref ds1307_init is known to be in place */
+	uint8_t regs[DS1307_TIME_REG_COUNT]; /*!< Raw timekeeping register image of the last read */
+	uint8_t decoded; /*!< Bitmap of DS1307_FIELD_* values already decoded from regs */
+	uint8_t dirty; /*!< Bitmap of DS1307_FIELD_* values waiting for @ref ds1307_commit */
+	ds1307_write_mode_t write_mode; /*!< Immediate or deferred setter writes */
+	ds1307_async_state_t async_state; /*!< State of the asynchronous transfer in progress */
+	ds1307_async_done_func_t async_done; /*!< Completion callback of the asynchronous operation */
+	uint8_t async_buf[DS1307_TIME_REG_COUNT]; /*!< Transfer buffer kept alive for the asynchronous transport */
+#if DS1307_CONFIG_STATS
+	ds1307_stats_t stats; /*!< Bus usage statistics of the blocking transfers */
+#endif
+};
+
+/**
+ * @brief  Century offset of a context (fixed to 2000 when DS1307_CONFIG_CENTURY is 0).
+ */
+#if DS1307_CONFIG_CENTURY
+#define DS1307_CENTURY(usr)		((usr)->century)
+#else
+#define DS1307_CENTURY(usr)		2000U
+#endif
+
+#if DS1307_CONFIG_FIELD_API
 
 /**
- * @brief Sends data to the DS1307 over I2C using user-defined function. (internal use only)
+ * @brief  Selects immediate or deferred (coalesced) writes for the setters.
  */
-static void ds1307_i2c_send(ds1307_context_t *usr, ds1307_adr_t address,
-		ds1307_reg_adr_t reg_adr, uint8_t *ds1307_data, uint16_t size);
+void ds1307_set_write_mode(ds1307_context_t *usr, ds1307_write_mode_t mode);
 
 /**
- * @brief Sets the minute value on the DS1307.
+ * @brief  Writes all dirty fields in one transfer covering the smallest contiguous register range.
  */
-static void ds1307_i2c_read(ds1307_context_t *usr, ds1307_adr_t address,
-		ds1307_reg_adr_t reg_adr, uint8_t *ds1307_data, uint16_t size);
+ds1307_status_t ds1307_commit(ds1307_context_t *usr);
+#endif /* DS1307_CONFIG_FIELD_API */
 
+/**
+ * @brief  Sequential access cursor over the battery-backed RAM.
+ */
+typedef struct {
+	ds1307_context_t *usr; /*!< DS1307 context used for I2C access */
+	uint8_t offset; /*!< Next RAM offset (0 to DS1307_RAM_SIZE) */
+} ds1307_nvram_stream_t;
+
+#if DS1307_CONFIG_FIELD_API
 /**
  * @brief  Sets the minute value.
  */
-void ds1307_set_minute(ds1307_context_t *usr, uint8_t minute);
+ds1307_status_t ds1307_set_minute(ds1307_context_t *usr, uint8_t minute);
 
 /**
  * @brief  Gets the minute value and updates the context.
  */
-void ds1307_get_minute(ds1307_context_t *usr);
+ds1307_status_t ds1307_get_minute(ds1307_context_t *usr);
 
 /**
  * @brief  Sets the second value.
  */
-void ds1307_set_second(ds1307_context_t *usr, uint8_t second);
+ds1307_status_t ds1307_set_second(ds1307_context_t *usr, uint8_t second);
 
 /**
  * @brief  Gets the second value and updates the context.
  */
-void ds1307_get_second(ds1307_context_t *usr);
+ds1307_status_t ds1307_get_second(ds1307_context_t *usr);
 
 /**
  * @brief  Sets the hour value. Format must be set in usr->time_format.
  */
-void ds1307_set_hour(ds1307_context_t *usr, uint8_t hour);
+ds1307_status_t ds1307_set_hour(ds1307_context_t *usr, uint8_t hour);
 
 /**
  * @brief  Gets the hour value and updates the context.
  */
-void ds1307_get_hour(ds1307_context_t *usr);
+ds1307_status_t ds1307_get_hour(ds1307_context_t *usr);
+#endif /* DS1307_CONFIG_FIELD_API */
 
+#if DS1307_CONFIG_12H
 /**
  * @brief  Sets the hour format (12H/24H) and updates the time accordingly.
  */
-void ds1307_set_time_format(ds1307_context_t *usr, ds_1307_hour_format_t format);
+ds1307_status_t ds1307_set_time_format(ds1307_context_t *usr,
+		ds_1307_hour_format_t format);
+#endif
 
+#if DS1307_CONFIG_FIELD_API
 /**
  * @brief  Sets the day of the week.
  */
-void ds1307_set_day(ds1307_context_t *usr, ds1307_day_t day);
+ds1307_status_t ds1307_set_day(ds1307_context_t *usr, ds1307_day_t day);
 
 /**
  * @brief  Gets the day of the week and updates the context.
  */
-void ds1307_get_day(ds1307_context_t *usr);
+ds1307_status_t ds1307_get_day(ds1307_context_t *usr);
 
 /**
  * @brief  Sets the date (day of the month).
  */
-void ds1307_set_date(ds1307_context_t *usr, uint8_t date);
+ds1307_status_t ds1307_set_date(ds1307_context_t *usr, uint8_t date);
 
 /**
  * @brief  Gets the date and updates the context.
  */
-void ds1307_get_date(ds1307_context_t *usr);
+ds1307_status_t ds1307_get_date(ds1307_context_t *usr);
 
 /**
  * @brief  Sets the month value.
  */
-void ds1307_set_month(ds1307_context_t *usr, ds1307_month_t month);
+ds1307_status_t ds1307_set_month(ds1307_context_t *usr, ds1307_month_t month);
 
 /**
  * @brief  Gets the month and updates the context.
  */
-void ds1307_get_month(ds1307_context_t *usr);
+ds1307_status_t ds1307_get_month(ds1307_context_t *usr);
 
 /**
  * @brief  Sets the full year value (century stored separately).
  */
-void ds1307_set_year(ds1307_context_t *usr, uint16_t year);
+ds1307_status_t ds1307_set_year(ds1307_context_t *usr, uint16_t year);
 
 /**
  * @brief  Gets the full year and updates the context.
  */
-void ds1307_get_year(ds1307_context_t *usr);
+ds1307_status_t ds1307_get_year(ds1307_context_t *usr);
+#endif /* DS1307_CONFIG_FIELD_API */
+
+/**
+ * @brief  Reads the time, control register and RAM marker in one burst and classifies the device state.
+ */
+ds1307_status_t ds1307_init(ds1307_context_t *usr, ds1307_boot_t *boot);
+
+/**
+ * @brief  Writes the RAM marker checked by @ref ds1307_init (call after setting a valid time).
+ */
+ds1307_status_t ds1307_init_mark(ds1307_context_t *usr);
 
 /**
- * @brief  Reads all date and time values from the DS1307 and updates the context.
+ * @brief  Reads the raw timekeeping registers in a single burst without decoding them.
  */
-void DS1307_read_date_time(ds1307_context_t *usr);
+ds1307_status_t ds1307_read_raw(ds1307_context_t *usr);
 
 /**
- * @brief  Converts a decimal value to BCD format (internal use only).
+ * @brief  Returns the second value, decoding it from the raw image on first use.
  */
-static uint8_t DecToBcd(uint8_t value);
+uint8_t ds1307_second(ds1307_context_t *usr);
 
 /**
- * @brief  Converts a BCD value to decimal format (internal use only).
+ * @brief  Returns the minute value, decoding it from the raw image on first use.
  */
-static uint8_t BcdToDec(uint8_t value);
+uint8_t ds1307_minute(ds1307_context_t *usr);
+
+/**
+ * @brief  Returns the hour value, decoding it (with format and AM/PM) from the raw image on first use.
+ */
+uint8_t ds1307_hour(ds1307_context_t *usr);
+
+/**
+ * @brief  Returns the day of the week, decoding it from the raw image on first use.
+ */
+ds1307_day_t ds1307_day(ds1307_context_t *usr);
+
+/**
+ * @brief  Returns the date, decoding it from the raw image on first use.
+ */
+uint8_t ds1307_date(ds1307_context_t *usr);
+
+/**
+ * @brief  Returns the month, decoding it from the raw image on first use.
+ */
+ds1307_month_t ds1307_month(ds1307_context_t *usr);
+
+/**
+ * @brief  Returns the full year, decoding it from the raw image on first use.
+ */
+uint16_t ds1307_year(ds1307_context_t *usr);
+
+/**
+ * @brief  Writes all date and time values from the context to the DS1307 in a single burst.
+ */
+ds1307_status_t ds1307_set_date_time(ds1307_context_t *usr);
+
+/**
+ * @brief  Writes all date and time values and the oscillator state (CH bit) in a single burst.
+ */
+ds1307_status_t ds1307_set_date_time_clock(ds1307_context_t *usr,
+		ds1307_clock_t clock);
+
+/**
+ * @brief  Reads all date and time values from the DS1307 in a single burst, consistent across a seconds
+ *         rollover because the device latches the registers at the I2C START, and updates the context.
+ */
+ds1307_status_t DS1307_read_date_time(ds1307_context_t *usr);
+
+/**
+ * @brief  Starts a non-blocking burst read of the date and time.
+ */
+ds1307_status_t ds1307_read_date_time_async(ds1307_context_t *usr,
+		ds1307_async_done_func_t done);
+
+/**
+ * @brief  Starts a non-blocking burst write of the date and time held in the context.
+ */
+ds1307_status_t ds1307_set_date_time_async(ds1307_context_t *usr,
+		ds1307_async_done_func_t done);
+
+/**
+ * @brief  Completes the asynchronous operation in progress (call from the transfer complete ISR).
+ */
+void ds1307_async_complete(ds1307_context_t *usr, ds1307_status_t status);
+
+/**
+ * @brief  Polls the asynchronous transport and completes the operation when the transfer has finished.
+ */
+ds1307_status_t ds1307_async_poll(ds1307_context_t *usr);
+
+/**
+ * @brief  Returns non-zero while an asynchronous operation is in progress.
+ */
+uint8_t ds1307_async_busy(const ds1307_context_t *usr);
+
+/**
+ * @brief  Advances the date and time held in the context by a number of seconds (no I2C access).
+ */
+void ds1307_add_seconds(ds1307_context_t *usr, uint32_t seconds);
+
+/**
+ * @brief  Converts the date and time held in the context to a Unix timestamp.
+ */
+uint32_t ds1307_to_epoch(const ds1307_context_t *usr);
+
+/**
+ * @brief  Loads a Unix timestamp into the date and time fields of the context.
+ */
+void ds1307_from_epoch(ds1307_context_t *usr, uint32_t epoch);
+
+/**
+ * @brief  Reads the date and time from the DS1307 in a single burst into a compact timestamp.
+ */
+ds1307_status_t ds1307_compact_read(ds1307_context_t *usr,
+		ds1307_compact_t *time);
+
+/**
+ * @brief  Writes a compact timestamp to the DS1307 in a single burst.
+ */
+ds1307_status_t ds1307_compact_write(ds1307_context_t *usr,
+		const ds1307_compact_t *time);
+
+/**
+ * @brief  Encodes the date and time held in the context into a compact timestamp (no I2C access).
+ */
+void ds1307_compact_pack(ds1307_context_t *usr, ds1307_compact_t *time);
+
+/**
+ * @brief  Decodes a compact timestamp into the date and time fields of the context (no I2C access).
+ */
+void ds1307_compact_unpack(ds1307_context_t *usr, const ds1307_compact_t *time);
+
+/**
+ * @brief  Publishes a compact timestamp to a snapshot (single updater, no I2C access).
+ */
+void ds1307_snapshot_publish(ds1307_snapshot_t *snapshot,
+		const ds1307_compact_t *time);
+
+/**
+ * @brief  Reads the device and publishes the result to a snapshot.
+ */
+ds1307_status_t ds1307_snapshot_update(ds1307_context_t *usr,
+		ds1307_snapshot_t *snapshot);
+
+/**
+ * @brief  Copies the published timestamp without locking; returns DS1307_BUSY while an update is in progress.
+ */
+ds1307_status_t ds1307_snapshot_read(const ds1307_snapshot_t *snapshot,
+		ds1307_compact_t *time);
+
+/**
+ * @brief  Decodes the second value of a compact timestamp.
+ */
+uint8_t ds1307_compact_second(const ds1307_compact_t *time);
+
+/**
+ * @brief  Decodes the minute value of a compact timestamp.
+ */
+uint8_t ds1307_compact_minute(const ds1307_compact_t *time);
+
+/**
+ * @brief  Decodes the hour value of a compact timestamp in 24-hour format.
+ */
+uint8_t ds1307_compact_hour(const ds1307_compact_t *time);
+
+/**
+ * @brief  Decodes the day of the week of a compact timestamp.
+ */
+ds1307_day_t ds1307_compact_day(const ds1307_compact_t *time);
+
+/**
+ * @brief  Decodes the date (day of the month) of a compact timestamp.
+ */
+uint8_t ds1307_compact_date(const ds1307_compact_t *time);
+
+/**
+ * @brief  Decodes the month of a compact timestamp.
+ */
+ds1307_month_t ds1307_compact_month(const ds1307_compact_t *time);
+
+/**
+ * @brief  Decodes the full year of a compact timestamp.
+ */
+uint16_t ds1307_compact_year(const ds1307_compact_t *time);
+
+/**
+ * @brief  Advances the context by one second (call from the 1 Hz SQW/OUT edge ISR, no I2C access).
+ */
+void ds1307_tick(ds1307_context_t *usr);
+
+/**
+ * @brief  Configures the SQW/OUT pin.
+ */
+ds1307_status_t ds1307_set_sqw(ds1307_context_t *usr, ds1307_sqw_t sqw);
+
+/**
+ * @brief  Gets the SQW/OUT pin configuration and updates the context.
+ */
+ds1307_status_t ds1307_get_sqw(ds1307_context_t *usr);
+
+/**
+ * @brief  Reads bytes from the battery-backed RAM.
+ * @note   Offsets count from the first RAM byte (register 0x08). When @ref ds1307_init is used,
+ *         offsets 0 to DS1307_INIT_MAGIC_SIZE - 1 hold its marker; the journal and calibration
+ *         modules refuse regions that start below DS1307_INIT_MAGIC_SIZE.
+ */
+ds1307_status_t ds1307_nvram_read(ds1307_context_t *usr, uint8_t offset,
+		uint8_t *data, uint8_t length);
+
+/**
+ * @brief  Writes bytes to the battery-backed RAM.
+ */
+ds1307_status_t ds1307_nvram_write(ds1307_context_t *usr, uint8_t offset,
+		uint8_t *data, uint8_t length);
+
+/**
+ * @brief  Initializes a sequential NVRAM stream at an offset.
+ */
+void ds1307_nvram_stream_open(ds1307_nvram_stream_t *stream,
+		ds1307_context_t *usr, uint8_t offset);
+
+/**
+ * @brief  Reads the next bytes of an NVRAM stream.
+ */
+ds1307_status_t ds1307_nvram_stream_read(ds1307_nvram_stream_t *stream,
+		uint8_t *data, uint8_t length, uint8_t *count);
+
+/**
+ * @brief  Writes the next bytes of an NVRAM stream.
+ */
+ds1307_status_t ds1307_nvram_stream_write(ds1307_nvram_stream_t *stream,
+		uint8_t *data, uint8_t length, uint8_t *count);
+
+/**
+ * @brief  Computes the CRC-8 (polynomial 0x07) used by the NVRAM records of the optional modules.
+ */
+uint8_t ds1307_crc8(const uint8_t *data, uint8_t length);
+
+/**
+ * @brief  Takes the bus lock of the context (no-op without lock hooks); may be nested.
+ */
+void ds1307_lock(ds1307_context_t *usr);
+
+/**
+ * @brief  Releases the bus lock taken with @ref ds1307_lock.
+ */
+void ds1307_unlock(ds1307_context_t *usr);
 
 /**
  * @brief  Enables or disables the DS1307 oscillator via CH bit.
  */
-void ds1307_set_ch(ds1307_context_t *usr, ds1307_clock_t value);
+ds1307_status_t ds1307_set_ch(ds1307_context_t *usr, ds1307_clock_t value);
+
+#if DS1307_CONFIG_STATS
+/**
+ * @brief  Clears the bus usage statistics of a context.
+ */
+void ds1307_stats_reset(ds1307_context_t *usr);
+
+/**
+ * @brief  Returns the average transport call latency in cycle counter ticks (0 if nothing was measured).
+ */
+uint32_t ds1307_stats_avg_latency(const ds1307_context_t *usr);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
 
 #endif /* INC_DS1307_H_ */
@@ -0,0 +1,312 @@
+/**
+  ******************************************************************************
+  * @file    DS1307.hpp
+  * @author  iek2443
+  * @brief   Header-only C++ wrapper for the DS1307 RTC driver.
+  *          Contains the DS1307<Transport> class template, constexpr BCD
+  *          and calendar helpers, and std::chrono time point conversions.
+  ******************************************************************************
+  * @attention
+  *
+  * The transport is a template parameter, so every bus access is a direct
+  * call the compiler can inline, and register addresses are compile-time
+  * constants. The register and status enums are shared with DS1307.h.
+  * Requires C++14; test/ds1307_hpp_test.cpp builds it on the host.
+  *
+  * A transport is any copyable type providing:
+  *
+  *   ds1307_status_t write(ds1307_adr_t address, ds1307_reg_adr_t reg_adr,
+  *                         uint8_t *data, uint16_t size);
+  *   ds1307_status_t read(ds1307_adr_t address, ds1307_reg_adr_t reg_adr,
+  *                        uint8_t *data, uint16_t size);
+  *
+  ******************************************************************************
+  */
+
+#ifndef INC_DS1307_HPP_
+#define INC_DS1307_HPP_
+
+#include "DS1307.h"
+
+#include <chrono>
+#include <cstdint>
+
+namespace ds1307 {
+
+/**
+ * @brief  Time point type returned by the wrapper (whole seconds of the system clock, Unix epoch).
+ */
+using time_point = std::chrono::time_point<std::chrono::system_clock,
+		std::chrono::seconds>;
+
+/**
+ * @brief  Decoded date and time. The hour is always in 24-hour format.
+ */
+struct date_time {
+	uint16_t year; /*!< Full 4-digit year (2000–2099) */
+	ds1307_month_t month; /*!< Month of the year (1 = January, 12 = December) */
+	uint8_t date; /*!< Day of the month (1–31) */
+	ds1307_day_t day; /*!< Day of the week (1 = Monday, 7 = Sunday) */
+	uint8_t hour; /*!< Hour (0–23) */
+	uint8_t minute; /*!< Minute (0–59) */
+	uint8_t second; /*!< Second (0–59) */
+};
+
+/**
+ * @brief  Converts a decimal value (0–99) to BCD.
+ */
+constexpr uint8_t to_bcd(uint8_t value) {
+	return static_cast<uint8_t>(((value / 10U) << 4) | (value % 10U));
+}
+
+/**
+ * @brief  Converts a BCD value to decimal.
+ */
+constexpr uint8_t from_bcd(uint8_t value) {
+	return static_cast<uint8_t>((value >> 4) * 10U + (value & 0x0FU));
+}
+
+/**
+ * @brief  Converts a raw hour register value, in 12-hour or 24-hour layout, to a 24-hour value.
+ */
+constexpr uint8_t raw_hour_to_24(uint8_t hour) {
+	return (hour & 0x40U) ?
+			static_cast<uint8_t>(from_bcd(hour & 0x1FU) % 12U
+					+ ((hour & 0x20U) ? 12U : 0U)) :
+			from_bcd(hour & 0x3FU);
+}
+
+/**
+ * @brief  Returns the number of days since 1970-01-01 of a civil date.
+ */
+constexpr int32_t days_from_civil(int32_t y, uint32_t m, uint32_t d) {
+	y -= (m <= 2U) ? 1 : 0;
+	const int32_t era = (y >= 0 ? y : y - 399) / 400;
+	const uint32_t yoe = static_cast<uint32_t>(y - era * 400);
+	const uint32_t doy = (153U * (m > 2U ? m - 3U : m + 9U) + 2U) / 5U + d - 1U;
+	const uint32_t doe = yoe * 365U + yoe / 4U - yoe / 100U + doy;
+	return era * 146097 + static_cast<int32_t>(doe) - 719468;
+}
+
+/**
+ * @brief  Converts a decoded date and time to a Unix timestamp.
+ */
+constexpr uint32_t to_epoch(const date_time &t) {
+	return static_cast<uint32_t>(days_from_civil(t.year, t.month, t.date))
+			* 86400U + (t.hour * 60U + t.minute) * 60U + t.second;
+}
+
+/**
+ * @brief  Converts a Unix timestamp to a decoded date and time (civil_from_days).
+ */
+constexpr date_time from_epoch(uint32_t epoch) {
+	const uint32_t days = epoch / 86400U;
+	const uint32_t rem = epoch % 86400U;
+	const uint32_t z = days + 719468U;
+	const uint32_t era = z / 146097U;
+	const uint32_t doe = z - era * 146097U;
+	const uint32_t yoe = (doe - doe / 1460U + doe / 36524U - doe / 146096U) / 365U;
+	const uint32_t doy = doe - (365U * yoe + yoe / 4U - yoe / 100U);
+	const uint32_t mp = (5U * doy + 2U) / 153U;
+	const uint32_t d = doy - (153U * mp + 2U) / 5U + 1U;
+	const uint32_t m = (mp < 10U) ? mp + 3U : mp - 9U;
+	const uint32_t y = yoe + era * 400U + ((m <= 2U) ? 1U : 0U);
+
+	return date_time { static_cast<uint16_t>(y),
+			static_cast<ds1307_month_t>(m), static_cast<uint8_t>(d),
+			static_cast<ds1307_day_t>((days + 3U) % 7U + 1U),
+			static_cast<uint8_t>(rem / 3600U),
+			static_cast<uint8_t>((rem / 60U) % 60U),
+			static_cast<uint8_t>(rem % 60U) };
+}
+
+static_assert(to_bcd(59) == 0x59 && from_bcd(0x59) == 59, "BCD codec");
+static_assert(raw_hour_to_24(0x52) == 0 && raw_hour_to_24(0x72) == 12
+		&& raw_hour_to_24(0x21) == 21, "hour decoding");
+static_assert(to_epoch(date_time { 2000, DS1307_JANUARY, 1, DS1307_SATURDAY,
+		0, 0, 0 }) == DS1307_EPOCH_2000, "epoch");
+
+/**
+ * @brief  DS1307 device bound to a compile-time transport.
+ * @tparam Transport Type implementing the read and write functions described in the file header.
+ * @note   Unlike @ref ds1307_context_t no decoded copy of the time is kept; every call is one
+ *         bus transfer. The device is always written in 24-hour layout and may be read in either.
+ */
+template<class Transport>
+class DS1307 {
+public:
+	/**
+	 * @brief  Creates the device wrapper.
+	 * @param  transport: Transport instance (copied).
+	 */
+	explicit DS1307(Transport transport = Transport()) :
+			transport_(transport) {
+	}
+
+	/**
+	 * @brief  Writes one register.
+	 * @tparam Reg Register address, folded into the transport call at compile time.
+	 * @param  value: Raw register value.
+	 * @retval Status returned by the transport.
+	 */
+	template<ds1307_reg_adr_t Reg>
+	ds1307_status_t write_register(uint8_t value) {
+		return transport_.write(DS1307_WRITE_ADR, Reg, &value, 1);
+	}
+
+	/**
+	 * @brief  Reads one register.
+	 * @tparam Reg Register address, folded into the transport call at compile time.
+	 * @param  value: Receives the raw register value.
+	 * @retval Status returned by the transport.
+	 */
+	template<ds1307_reg_adr_t Reg>
+	ds1307_status_t read_register(uint8_t &value) {
+		return transport_.read(DS1307_READ_ADR, Reg, &value, 1);
+	}
+
+	/**
+	 * @brief  Writes the seconds register (0–59). Clears the CH bit.
+	 */
+	ds1307_status_t set_second(uint8_t second) {
+		return write_register<DS1307_SEC_REG_ADR>(to_bcd(second));
+	}
+
+	/**
+	 * @brief  Writes the minutes register (0–59).
+	 */
+	ds1307_status_t set_minute(uint8_t minute) {
+		return write_register<DS1307_MIN_REG_ADR>(to_bcd(minute));
+	}
+
+	/**
+	 * @brief  Writes the hours register in 24-hour layout (0–23).
+	 */
+	ds1307_status_t set_hour(uint8_t hour) {
+		return write_register<DS1307_HOUR_REG_ADR>(to_bcd(hour));
+	}
+
+	/**
+	 * @brief  Writes the day of the week register.
+	 */
+	ds1307_status_t set_day(ds1307_day_t day) {
+		return write_register<DS1307_DAY_REG_ADR>(static_cast<uint8_t>(day));
+	}
+
+	/**
+	 * @brief  Writes the day of the month register (1–31).
+	 */
+	ds1307_status_t set_date(uint8_t date) {
+		return write_register<DS1307_DATE_REG_ADR>(to_bcd(date));
+	}
+
+	/**
+	 * @brief  Writes the month register.
+	 */
+	ds1307_status_t set_month(ds1307_month_t month) {
+		return write_register<DS1307_MONTH_REG_ADR>(
+				to_bcd(static_cast<uint8_t>(month)));
+	}
+
+	/**
+	 * @brief  Writes the last two digits of the year.
+	 */
+	ds1307_status_t set_year(uint16_t year) {
+		return write_register<DS1307_YEAR_REG_ADR>(
+				to_bcd(static_cast<uint8_t>(year % 100U)));
+	}
+
+	/**
+	 * @brief  Writes the control register (SQW/OUT configuration).
+	 * @note   Does not update the RAM marker of ds1307_init(); on a marked device use ds1307_set_sqw().
+	 */
+	ds1307_status_t set_sqw(ds1307_sqw_t sqw) {
+		return write_register<DS1307_CONT_REG_ADR>(static_cast<uint8_t>(sqw));
+	}
+
+	/**
+	 * @brief  Reads the full date and time in one burst.
+	 * @param  out: Receives the decoded date and time (unchanged on failure).
+	 * @retval Status returned by the transport.
+	 */
+	ds1307_status_t read(date_time &out) {
+		uint8_t regs[DS1307_TIME_REG_COUNT];
+		const ds1307_status_t status = transport_.read(DS1307_READ_ADR,
+				DS1307_SEC_REG_ADR, regs, DS1307_TIME_REG_COUNT);
+
+		if (status == DS1307_OK) {
+			out = decode(regs);
+		}
+		return status;
+	}
+
+	/**
+	 * @brief  Writes the full date and time in one burst.
+	 * @param  in: Date and time to write (24-hour format).
+	 * @param  clock: Oscillator state written with the seconds register.
+	 * @retval Status returned by the transport.
+	 */
+	ds1307_status_t write(const date_time &in,
+			ds1307_clock_t clock = DS1307_CLOCK_ENABLE) {
+		uint8_t regs[DS1307_TIME_REG_COUNT] = { static_cast<uint8_t>(to_bcd(
+				in.second) | (clock == DS1307_CLOCK_DISABLE ? 0x80U : 0U)),
+				to_bcd(in.minute), to_bcd(in.hour),
+				static_cast<uint8_t>(in.day), to_bcd(in.date),
+				to_bcd(static_cast<uint8_t>(in.month)),
+				to_bcd(static_cast<uint8_t>(in.year % 100U)) };
+
+		return transport_.write(DS1307_WRITE_ADR, DS1307_SEC_REG_ADR, regs,
+				DS1307_TIME_REG_COUNT);
+	}
+
+	/**
+	 * @brief  Reads the current time as a std::chrono time point.
+	 * @param  tp: Receives the time point (unchanged on failure).
+	 * @retval Status returned by the transport.
+	 */
+	ds1307_status_t now(time_point &tp) {
+		date_time t { };
+		const ds1307_status_t status = read(t);
+
+		if (status == DS1307_OK) {
+			tp = time_point(std::chrono::seconds(to_epoch(t)));
+		}
+		return status;
+	}
+
+	/**
+	 * @brief  Sets the device from a std::chrono time point and starts the oscillator.
+	 * @param  tp: Time point between 2000-01-01 and 2099-12-31.
+	 * @retval Status returned by the transport.
+	 */
+	ds1307_status_t set(time_point tp) {
+		return write(from_epoch(static_cast<uint32_t>(
+				tp.time_since_epoch().count())));
+	}
+
+	/**
+	 * @brief  Returns the transport instance.
+	 */
+	Transport& transport() {
+		return transport_;
+	}
+
+private:
+	static date_time decode(const uint8_t *regs) {
+		return date_time { static_cast<uint16_t>(2000U
+				+ from_bcd(regs[DS1307_YEAR_REG_ADR])),
+				static_cast<ds1307_month_t>(from_bcd(
+						regs[DS1307_MONTH_REG_ADR])),
+				from_bcd(regs[DS1307_DATE_REG_ADR]),
+				static_cast<ds1307_day_t>(regs[DS1307_DAY_REG_ADR] & 0x07U),
+				raw_hour_to_24(regs[DS1307_HOUR_REG_ADR]),
+				from_bcd(regs[DS1307_MIN_REG_ADR]),
+				from_bcd(regs[DS1307_SEC_REG_ADR] & 0x7FU) };
+	}
+
+	Transport transport_;
+};
+
+} /* namespace ds1307 */
+
+#endif /* INC_DS1307_HPP_ */
@@ -0,0 +1,254 @@
+/**
+  ******************************************************************************
+  * @file    DS1307_alarm.c
+  * @author  iek2443
+  * @brief   Source file for the DS1307 software alarm engine.
+  *          Keeps the pending alarms in a binary min-heap ordered by deadline
+  *          and fires them as the time fed by the application advances.
+  ******************************************************************************
+  * @attention
+  *
+  * A tick with no alarm due only compares the deadline at the top of the
+  * heap. Adding, cancelling and firing an alarm cost O(log n) moves in the
+  * pool. Deadlines are compared with wrap-around arithmetic.
+  *
+  ******************************************************************************
+  */
+#include "DS1307_alarm.h"
+
+static uint8_t ds1307_alarm_before(const ds1307_alarm_t *a,
+		const ds1307_alarm_t *b);
+static void ds1307_alarm_sift_up(ds1307_alarm_engine_t *engine, uint8_t index);
+static void ds1307_alarm_sift_down(ds1307_alarm_engine_t *engine,
+		uint8_t index);
+static void ds1307_alarm_remove(ds1307_alarm_engine_t *engine, uint8_t index);
+
+/**
+  * @brief  Initializes the alarm engine.
+  * @param  engine: Pointer to the alarm engine structure to initialize.
+  * @param  pool: User-provided array of alarm entries.
+  * @param  capacity: Number of entries in the pool.
+  * @param  now: Current time as a Unix timestamp (e.g. from @ref ds1307_to_epoch).
+  * @retval None
+  */
+void ds1307_alarm_init(ds1307_alarm_engine_t *engine, ds1307_alarm_t *pool,
+		uint8_t capacity, uint32_t now) {
+	engine->heap = pool;
+	engine->capacity = capacity;
+	engine->count = 0;
+	engine->next_id = 0;
+	engine->now = now;
+	engine->sqw_edges = 0;
+	engine->sqw_seen = 0;
+}
+
+/**
+  * @brief  Adds an alarm.
+  * @param  engine: Pointer to the alarm engine structure.
+  * @param  deadline: Unix timestamp at which the alarm fires. A deadline that is already past
+  *                   fires on the next tick.
+  * @param  period: Repeat period in seconds, or 0 for a one-shot alarm.
+  * @param  callback: Function called when the alarm fires.
+  * @param  user: User data passed to the callback (may be NULL).
+  * @retval Identifier of the alarm (1–255), or 0 if the pool is full.
+  */
+uint8_t ds1307_alarm_add(ds1307_alarm_engine_t *engine, uint32_t deadline,
+		uint32_t period, ds1307_alarm_func_t callback, void *user) {
+	ds1307_alarm_t *alarm;
+	uint8_t i;
+
+	if (engine->count >= engine->capacity) {
+		return 0;
+	}
+	/* Skip identifiers of pending alarms; a free one exists since count < 255 */
+	do {
+		engine->next_id++;
+		if (engine->next_id == 0) {
+			engine->next_id = 1;
+		}
+		for (i = 0; i < engine->count; i++) {
+			if (engine->heap[i].id == engine->next_id) {
+				break;
+			}
+		}
+	} while (i < engine->count);
+
+	alarm = &engine->heap[engine->count];
+	alarm->deadline = deadline;
+	alarm->period = period;
+	alarm->callback = callback;
+	alarm->user = user;
+	alarm->id = engine->next_id;
+	engine->count++;
+	ds1307_alarm_sift_up(engine, (uint8_t) (engine->count - 1U));
+	return engine->next_id;
+}
+
+/**
+  * @brief  Cancels a pending alarm.
+  * @param  engine: Pointer to the alarm engine structure.
+  * @param  id: Identifier returned by @ref ds1307_alarm_add.
+  * @retval 1 if the alarm was cancelled, 0 if no pending alarm has this identifier.
+  */
+uint8_t ds1307_alarm_cancel(ds1307_alarm_engine_t *engine, uint8_t id) {
+	uint8_t i;
+
+	for (i = 0; i < engine->count; i++) {
+		if (engine->heap[i].id == id) {
+			ds1307_alarm_remove(engine, i);
+			return 1;
+		}
+	}
+	return 0;
+}
+
+/**
+  * @brief  Returns the earliest pending deadline.
+  * @param  engine: Pointer to the alarm engine structure.
+  * @retval Deadline at the top of the heap, or 0 if no alarm is pending.
+  * @note   Useful to sleep until the next alarm instead of ticking every second.
+  */
+uint32_t ds1307_alarm_next(const ds1307_alarm_engine_t *engine) {
+	return engine->count ? engine->heap[0].deadline : 0U;
+}
+
+/**
+  * @brief  Advances the engine to the given time and fires the alarms that are due.
+  * @param  engine: Pointer to the alarm engine structure.
+  * @param  now: Current time as a Unix timestamp, e.g. ds1307_to_epoch(ds1307_now(&cache)).
+  * @retval None
+  * @note   Alarms fire in deadline order. A periodic alarm is rescheduled before its callback runs,
+  *         to the first deadline after now, so an alarm missed for several periods fires once.
+  *         Time may also be fed backwards, e.g. after a clock correction; no alarm fires until
+  *         its deadline is reached again.
+  */
+void ds1307_alarm_tick(ds1307_alarm_engine_t *engine, uint32_t now) {
+	ds1307_alarm_t fired;
+	ds1307_alarm_t *top;
+
+	engine->now = now;
+	while (engine->count
+			&& (int32_t) (engine->heap[0].deadline - engine->now) <= 0) {
+		top = &engine->heap[0];
+		fired = *top;
+		if (top->period) {
+			top->deadline += top->period
+					* ((engine->now - top->deadline) / top->period + 1U);
+			ds1307_alarm_sift_down(engine, 0);
+		} else {
+			ds1307_alarm_remove(engine, 0);
+		}
+		if (fired.callback) {
+			fired.callback(fired.id, fired.deadline, fired.user);
+		}
+	}
+}
+
+/**
+  * @brief  Counts one SQW/OUT edge.
+  * @param  engine: Pointer to the alarm engine structure.
+  * @retval None
+  * @note   SQW/OUT must be configured for 1 Hz. Safe to call from the pin interrupt: only the edge
+  *         counter is written, and it is written by nobody else.
+  */
+void ds1307_alarm_sqw_edge(ds1307_alarm_engine_t *engine) {
+	engine->sqw_edges++;
+}
+
+/**
+  * @brief  Advances the engine by the SQW edges counted since the last call and fires the due alarms.
+  * @param  engine: Pointer to the alarm engine structure.
+  * @retval None
+  * @note   Call from the main loop or a task. Edges missed by a late call are not lost; they
+  *         are accounted together in one tick.
+  */
+void ds1307_alarm_poll(ds1307_alarm_engine_t *engine) {
+	uint32_t edges = engine->sqw_edges;
+	uint32_t elapsed = edges - engine->sqw_seen;
+
+	if (elapsed) {
+		engine->sqw_seen = edges;
+		ds1307_alarm_tick(engine, engine->now + elapsed);
+	}
+}
+
+/**
+  * @brief  Returns whether an alarm is due before another one.
+  * @param  a: First alarm.
+  * @param  b: Second alarm.
+  * @retval Non-zero if a has the earlier deadline.
+  */
+static uint8_t ds1307_alarm_before(const ds1307_alarm_t *a,
+		const ds1307_alarm_t *b) {
+	return (int32_t) (a->deadline - b->deadline) < 0;
+}
+
+/**
+  * @brief  Moves an entry up the heap until its parent is not later.
+  * @param  engine: Pointer to the alarm engine structure.
+  * @param  index: Heap index of the entry.
+  * @retval None
+  */
+static void ds1307_alarm_sift_up(ds1307_alarm_engine_t *engine, uint8_t index) {
+	ds1307_alarm_t *heap = engine->heap;
+	ds1307_alarm_t entry = heap[index];
+	uint8_t parent;
+
+	while (index > 0) {
+		parent = (uint8_t) ((index - 1U) >> 1);
+		if (!ds1307_alarm_before(&entry, &heap[parent])) {
+			break;
+		}
+		heap[index] = heap[parent];
+		index = parent;
+	}
+	heap[index] = entry;
+}
+
+/**
+  * @brief  Moves an entry down the heap until no child is earlier.
+  * @param  engine: Pointer to the alarm engine structure.
+  * @param  index: Heap index of the entry.
+  * @retval None
+  */
+static void ds1307_alarm_sift_down(ds1307_alarm_engine_t *engine,
+		uint8_t index) {
+	ds1307_alarm_t *heap = engine->heap;
+	ds1307_alarm_t entry = heap[index];
+	uint16_t child;
+
+	while ((child = (uint16_t) (2U * index + 1U)) < engine->count) {
+		if (child + 1U < engine->count
+				&& ds1307_alarm_before(&heap[child + 1U], &heap[child])) {
+			child++;
+		}
+		if (!ds1307_alarm_before(&heap[child], &entry)) {
+			break;
+		}
+		heap[index] = heap[child];
+		index = (uint8_t) child;
+	}
+	heap[index] = entry;
+}
+
+/**
+  * @brief  Removes an entry from the heap.
+  * @param  engine: Pointer to the alarm engine structure.
+  * @param  index: Heap index of the entry.
+  * @retval None
+  * @note   The last entry takes its place and is moved up or down as needed.
+  */
+static void ds1307_alarm_remove(ds1307_alarm_engine_t *engine, uint8_t index) {
+	engine->count--;
+	if (index == engine->count) {
+		return;
+	}
+	engine->heap[index] = engine->heap[engine->count];
+	if (index > 0
+			&& ds1307_alarm_before(&engine->heap[index],
+					&engine->heap[(index - 1U) >> 1])) {
+		ds1307_alarm_sift_up(engine, index);
+	} else {
+		ds1307_alarm_sift_down(engine, index);
+	}
+}
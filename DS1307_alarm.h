@@ -0,0 +1,103 @@
+/**
+  ******************************************************************************
+  * @file    DS1307_alarm.h
+  * @author  iek2443
+  * @brief   Header file for the DS1307 software alarm engine.
+  *          Contains the alarm structures and function prototypes for
+  *          one-shot and periodic alarms on Unix timestamp deadlines.
+  ******************************************************************************
+  * @attention
+  *
+  * The DS1307 has no alarm registers. The alarms are kept in a min-heap
+  * ordered by deadline, in a user-provided pool, and are fed with the current
+  * time by the application: a Unix timestamp from the cached clock, or the
+  * 1 Hz SQW/OUT edges. No I2C access is made by the engine.
+  *
+  ******************************************************************************
+  */
+
+#ifndef INC_DS1307_ALARM_H_
+#define INC_DS1307_ALARM_H_
+
+#include "DS1307.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief  Function pointer type for the alarm callback.
+ * @param  id: Identifier returned by @ref ds1307_alarm_add.
+ * @param  deadline: Deadline the alarm fired for.
+ * @param  user: User data given when the alarm was added.
+ * @retval None
+ * @note   The callback may add and cancel alarms, including its own.
+ */
+typedef void (*ds1307_alarm_func_t)(uint8_t id, uint32_t deadline, void *user);
+
+/**
+ * @brief  Entry of the alarm pool.
+ */
+typedef struct {
+	uint32_t deadline; /*!< Unix timestamp at which the alarm fires */
+	uint32_t period; /*!< Repeat period in seconds (0 = one-shot) */
+	ds1307_alarm_func_t callback; /*!< Callback function */
+	void *user; /*!< User data passed to the callback */
+	uint8_t id; /*!< Identifier of the alarm */
+} ds1307_alarm_t;
+
+/**
+ * @brief  DS1307 alarm engine structure.
+ */
+typedef struct {
+	ds1307_alarm_t *heap; /*!< User-provided alarm pool, kept as a min-heap on the deadline */
+	uint8_t capacity; /*!< Number of entries in the pool */
+	uint8_t count; /*!< Number of pending alarms */
+	uint8_t next_id; /*!< Last identifier handed out */
+	uint32_t now; /*!< Time of the last tick */
+	volatile uint32_t sqw_edges; /*!< Incremented by @ref ds1307_alarm_sqw_edge */
+	uint32_t sqw_seen; /*!< SQW edges already accounted to now */
+} ds1307_alarm_engine_t;
+
+/**
+ * @brief  Initializes the alarm engine with a user-provided pool and the current time.
+ */
+void ds1307_alarm_init(ds1307_alarm_engine_t *engine, ds1307_alarm_t *pool,
+		uint8_t capacity, uint32_t now);
+
+/**
+ * @brief  Adds an alarm; returns its identifier, or 0 if the pool is full.
+ */
+uint8_t ds1307_alarm_add(ds1307_alarm_engine_t *engine, uint32_t deadline,
+		uint32_t period, ds1307_alarm_func_t callback, void *user);
+
+/**
+ * @brief  Cancels a pending alarm; returns 0 if it was not found.
+ */
+uint8_t ds1307_alarm_cancel(ds1307_alarm_engine_t *engine, uint8_t id);
+
+/**
+ * @brief  Returns the earliest pending deadline, or 0 if no alarm is pending.
+ */
+uint32_t ds1307_alarm_next(const ds1307_alarm_engine_t *engine);
+
+/**
+ * @brief  Advances the engine to the given time and fires the alarms that are due.
+ */
+void ds1307_alarm_tick(ds1307_alarm_engine_t *engine, uint32_t now);
+
+/**
+ * @brief  Counts one 1 Hz SQW/OUT edge; call from the pin interrupt (no callbacks are run).
+ */
+void ds1307_alarm_sqw_edge(ds1307_alarm_engine_t *engine);
+
+/**
+ * @brief  Advances the engine by the SQW edges counted since the last call and fires the due alarms.
+ */
+void ds1307_alarm_poll(ds1307_alarm_engine_t *engine);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_DS1307_ALARM_H_ */
@@ -0,0 +1,81 @@
+/**
+  ******************************************************************************
+  * @file    DS1307_cache.c
+  * @author  iek2443
+  * @brief   Source file for the DS1307 cached software clock.
+  *          Extrapolates the date and time from a monotonic millisecond tick
+  *          and re-synchronizes with the device on a configurable interval.
+  ******************************************************************************
+  * @attention
+  *
+  * The cached value is only as accurate as the anchor: the sub-second phase
+  * of the DS1307 is unknown when it is read, so the cached time may lag the
+  * device by up to one second.
+  *
+  ******************************************************************************
+  */
+#include "DS1307_cache.h"
+
+/**
+  * @brief  Initializes the cached clock and reads the device once.
+  * @param  cache: Pointer to the cache structure to initialize.
+  * @param  rtc: Pointer to a configured DS1307 context structure. Its date and time fields hold the cached values.
+  * @param  tick_ms: User-defined monotonic millisecond tick function.
+  * @param  resync_interval_ms: Interval after which @ref ds1307_now reads the device again (0 = never).
+  * @retval Status of the initial read. The cache is usable even if it fails, but holds the values
+  *         the context had before the call until the next successful sync.
+  */
+ds1307_status_t ds1307_cache_init(ds1307_cache_t *cache, ds1307_context_t *rtc,
+		ds1307_tick_func_t tick_ms, uint32_t resync_interval_ms) {
+	cache->rtc = rtc;
+	cache->tick_ms = tick_ms;
+	cache->resync_interval_ms = resync_interval_ms;
+	return ds1307_cache_sync(cache);
+}
+
+/**
+  * @brief  Reads the full date and time from the device and re-anchors the cache to the current tick.
+  * @param  cache: Pointer to the cache structure.
+  * @retval Status of the read.
+  * @note   The re-sync interval restarts even if the read fails, so a missing device is not polled on
+  *         every call of @ref ds1307_now. The second anchor is only moved on success.
+  */
+ds1307_status_t ds1307_cache_sync(ds1307_cache_t *cache) {
+	ds1307_status_t status = DS1307_read_date_time(cache->rtc);
+
+	cache->sync_tick = cache->tick_ms();
+	if (status == DS1307_OK) {
+		cache->second_tick = cache->sync_tick;
+	}
+	return status;
+}
+
+/**
+  * @brief  Returns the current date and time from the cache.
+  * @param  cache: Pointer to the cache structure.
+  * @retval Pointer to the bound context holding the current date and time.
+  * @note   The device is only accessed when the re-sync interval has elapsed. Otherwise the cached
+  *         value is advanced by the whole seconds elapsed on the tick, without any I2C transfer.
+  *         If a re-sync fails, the cached value keeps being advanced from the tick.
+  */
+const ds1307_context_t* ds1307_now(ds1307_cache_t *cache) {
+	uint32_t now = cache->tick_ms();
+	uint32_t elapsed;
+
+	if (cache->resync_interval_ms != 0
+			&& (uint32_t) (now - cache->sync_tick) >= cache->resync_interval_ms) {
+		if (ds1307_cache_sync(cache) == DS1307_OK) {
+			return cache->rtc;
+		}
+		now = cache->sync_tick;
+	}
+
+	elapsed = now - cache->second_tick;
+	if (elapsed >= 1000U) {
+		elapsed /= 1000U;
+		ds1307_add_seconds(cache->rtc, elapsed);
+		cache->second_tick += elapsed * 1000U;
+	}
+
+	return cache->rtc;
+}
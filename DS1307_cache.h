@@ -0,0 +1,66 @@
+/**
+  ******************************************************************************
+  * @file    DS1307_cache.h
+  * @author  iek2443
+  * @brief   Header file for the DS1307 cached software clock.
+  *          Contains the cache structure and function prototypes for reading
+  *          the current time without I2C access.
+  ******************************************************************************
+  * @attention
+  *
+  * The cache reads the DS1307 once, anchors the result to a user-supplied
+  * monotonic millisecond tick and extrapolates the time from that tick.
+  * The device is only read again when the configured re-sync interval
+  * has elapsed.
+  *
+  ******************************************************************************
+  */
+
+#ifndef INC_DS1307_CACHE_H_
+#define INC_DS1307_CACHE_H_
+
+#include "DS1307.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief  Function pointer type for the monotonic millisecond tick source.
+ * @retval Free-running millisecond counter (wrap-around is handled).
+ */
+typedef uint32_t (*ds1307_tick_func_t)(void);
+
+/**
+ * @brief  DS1307 cached clock structure.
+ * @note   The cached date and time are kept in the fields of the bound context.
+ */
+typedef struct {
+	ds1307_context_t *rtc; /*!< Bound DS1307 context, holds the cached date and time */
+	ds1307_tick_func_t tick_ms; /*!< User-defined millisecond tick function */
+	uint32_t resync_interval_ms; /*!< Interval after which the device is read again (0 = never) */
+	uint32_t sync_tick; /*!< Tick value at the last device read */
+	uint32_t second_tick; /*!< Tick value at which the cached second started */
+} ds1307_cache_t;
+
+/**
+ * @brief  Initializes the cache and reads the device once.
+ */
+ds1307_status_t ds1307_cache_init(ds1307_cache_t *cache, ds1307_context_t *rtc,
+		ds1307_tick_func_t tick_ms, uint32_t resync_interval_ms);
+
+/**
+ * @brief  Reads the device and re-anchors the cache to the current tick.
+ */
+ds1307_status_t ds1307_cache_sync(ds1307_cache_t *cache);
+
+/**
+ * @brief  Returns the current date and time, reading the device only when a re-sync is due.
+ */
+const ds1307_context_t* ds1307_now(ds1307_cache_t *cache);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_DS1307_CACHE_H_ */
@@ -0,0 +1,286 @@
+/**
+  ******************************************************************************
+  * @file    DS1307_calib.c
+  * @author  iek2443
+  * @brief   Source file for the DS1307 drift calibration.
+  *          Measures the drift of the device between reference syncs, keeps
+  *          it in battery-backed RAM and steps the seconds register to
+  *          compensate it.
+  ******************************************************************************
+  * @attention
+  *
+  * The device keeps counting uncorrected seconds. The seconds stepped back by
+  * the correction are recorded, so the uncorrected count since the anchor is
+  * always known and the next measurement is not disturbed by the steps or by
+  * early syncs.
+  *
+  ******************************************************************************
+  */
+#include "DS1307_calib.h"
+
+static ds1307_status_t ds1307_calib_store(ds1307_calib_t *calib,
+		const ds1307_calib_t *state, uint8_t offset);
+static void ds1307_calib_put32(uint8_t *p, uint32_t value);
+static uint32_t ds1307_calib_get32(const uint8_t *p);
+
+/**
+  * @brief  Loads the calibration stored in an NVRAM region.
+  * @param  calib: Pointer to the calibration structure to initialize.
+  * @param  rtc: Pointer to the configured DS1307 context structure.
+  * @param  base: NVRAM offset of a region of DS1307_CALIB_REGION_SIZE bytes.
+  * @param  restored: Optional pointer set to non-zero if a stored calibration was loaded (may be NULL).
+  * @retval Status of the NVRAM read, @ref DS1307_INVALID_PARAM if the region overlaps the
+  *         @ref ds1307_init marker.
+  * @note   A region without a valid magic byte and CRC leaves the structure unanchored, with no
+  *         drift correction; it is written on the first @ref ds1307_calib_sync.
+  */
+ds1307_status_t ds1307_calib_open(ds1307_calib_t *calib, ds1307_context_t *rtc,
+		uint8_t base, uint8_t *restored) {
+	uint8_t region[DS1307_CALIB_REGION_SIZE];
+	ds1307_status_t status;
+
+	if (base < DS1307_INIT_MAGIC_SIZE) {
+		return DS1307_INVALID_PARAM;
+	}
+	calib->rtc = rtc;
+	calib->base = base;
+	calib->anchored = 0;
+	calib->anchor = 0;
+	calib->drift_ppb = 0;
+	calib->stepped = 0;
+	if (restored) {
+		*restored = 0;
+	}
+
+	status = ds1307_nvram_read(rtc, base, region, DS1307_CALIB_REGION_SIZE);
+	if (status != DS1307_OK) {
+		return status;
+	}
+	if (region[0] == DS1307_CALIB_MAGIC
+			&& region[DS1307_CALIB_REGION_SIZE - 1U]
+					== ds1307_crc8(region, DS1307_CALIB_REGION_SIZE - 1U)) {
+		calib->anchored = 1;
+		calib->anchor = ds1307_calib_get32(&region[1]);
+		calib->drift_ppb = (int32_t) ds1307_calib_get32(&region[5]);
+		calib->stepped = (int32_t) ds1307_calib_get32(&region[9]);
+		if (restored) {
+			*restored = 1;
+		}
+	}
+	return DS1307_OK;
+}
+
+/**
+  * @brief  Sets the device to a reference time and updates the drift measurement.
+  * @param  calib: Pointer to the calibration structure.
+  * @param  reference: Reference Unix timestamp (e.g. from NTP or GPS) valid at the time of the call.
+  * @param  cache: Optional cached clock bound to the same context, re-synced afterwards (may be NULL).
+  * @retval Status of the transfers, or @ref DS1307_INVALID_DATA if a measured drift larger than
+  *         DS1307_CALIB_MAX_PPB was rejected (the time is still set and a new measurement started).
+  * @note   The device is read first to see how far it has run since the anchor. When at least
+  *         DS1307_CALIB_MIN_INTERVAL seconds of reference time have elapsed, the drift is measured
+  *         over the whole interval and a new interval is started at the reference. An earlier sync
+  *         only sets the time and records the offset as a step, so the interval keeps running.
+  *         The calibration state changes only when both the time and the NVRAM region have been
+  *         written. The bus lock of the context is held for the whole sequence.
+  */
+ds1307_status_t ds1307_calib_sync(ds1307_calib_t *calib, uint32_t reference,
+		ds1307_cache_t *cache) {
+	ds1307_calib_t state = *calib;
+	ds1307_status_t status;
+	ds1307_status_t result = DS1307_OK;
+	uint32_t now;
+
+	ds1307_lock(calib->rtc);
+	status = DS1307_read_date_time(calib->rtc);
+	if (status != DS1307_OK) {
+		ds1307_unlock(calib->rtc);
+		return status;
+	}
+	now = ds1307_to_epoch(calib->rtc);
+
+	if (!state.anchored) {
+		state.anchored = 1;
+		state.anchor = reference;
+		state.stepped = 0;
+	} else if ((int32_t) (reference - state.anchor)
+			>= (int32_t) DS1307_CALIB_MIN_INTERVAL) {
+		int64_t elapsed = (int64_t) (reference - state.anchor);
+		int64_t counted = (int64_t) now + state.stepped - state.anchor;
+		int64_t drift = (counted - elapsed) * 1000000000LL / elapsed;
+
+		if (drift > DS1307_CALIB_MAX_PPB || drift < -DS1307_CALIB_MAX_PPB) {
+			result = DS1307_INVALID_DATA;
+		} else {
+			state.drift_ppb = (int32_t) drift;
+		}
+		state.anchor = reference;
+		state.stepped = 0;
+	} else {
+		state.stepped += (int32_t) (now - reference);
+	}
+
+	ds1307_from_epoch(calib->rtc, reference);
+	status = ds1307_set_date_time(calib->rtc);
+	if (status == DS1307_OK) {
+		status = ds1307_calib_store(calib, &state, 0);
+	}
+	if (status == DS1307_OK) {
+		*calib = state;
+	}
+	ds1307_unlock(calib->rtc);
+
+	if (cache) {
+		ds1307_status_t sync = ds1307_cache_sync(cache);
+
+		if (status == DS1307_OK) {
+			status = sync;
+		}
+	}
+	return (status == DS1307_OK) ? result : status;
+}
+
+/**
+  * @brief  Returns the whole seconds the device is expected to be ahead, beyond the steps already made.
+  * @param  calib: Pointer to the calibration structure.
+  * @param  epoch: Current device time as a Unix timestamp.
+  * @retval Seconds to step the device back (negative: forward); 0 without an anchor.
+  * @note   The uncorrected count since the anchor is (epoch + stepped - anchor). A device running
+  *         d parts fast has counted (1 + d) seconds per reference second, so its error is
+  *         count * d / (1 + d), rounded to the nearest second.
+  */
+int32_t ds1307_calib_error(const ds1307_calib_t *calib, uint32_t epoch) {
+	int64_t counted;
+	int64_t error;
+
+	if (!calib->anchored || calib->drift_ppb == 0) {
+		return 0;
+	}
+	counted = (int64_t) epoch + calib->stepped - calib->anchor;
+	error = counted * calib->drift_ppb;
+	if (error >= 0) {
+		error = (2 * error + 1000000000LL + calib->drift_ppb)
+				/ (2 * (1000000000LL + calib->drift_ppb));
+	} else {
+		error = -((-2 * error + 1000000000LL + calib->drift_ppb)
+				/ (2 * (1000000000LL + calib->drift_ppb)));
+	}
+	return (int32_t) (error - calib->stepped);
+}
+
+/**
+  * @brief  Steps the seconds register by the predicted drift.
+  * @param  calib: Pointer to the calibration structure.
+  * @param  cache: Optional cached clock bound to the same context (may be NULL). When given, the
+  *                cache decides without bus access whether a step is due; the device is only read
+  *                when it is, and the cache is re-synced after the step.
+  * @retval Status of the transfers, or @ref DS1307_BUSY if the device is too close to a minute
+  *         rollover to step now (call again a few seconds later).
+  * @note   Only the seconds register is written, with @ref ds1307_set_second, so the step never
+  *         carries into the minutes; a larger correction is spread over several calls. Nothing is
+  *         written while the predicted error is below one second, so calling this once per minute
+  *         or on every cache re-sync is cheap. The step is computed from a device read made just
+  *         before it, since the cached time can lag the device by up to a second and
+  *         calib->stepped must record the step actually written. The context must be in immediate
+  *         write mode.
+  *         If the step succeeds but the NVRAM update fails, the step is kept in RAM and the next
+  *         measurement after a power cycle is off by that step.
+  */
+ds1307_status_t ds1307_calib_apply(ds1307_calib_t *calib, ds1307_cache_t *cache) {
+	ds1307_status_t status = DS1307_OK;
+	int32_t step;
+	int32_t second;
+
+	if (!calib->anchored || calib->drift_ppb == 0) {
+		return DS1307_OK;
+	}
+
+	ds1307_lock(calib->rtc);
+	if (cache && ds1307_calib_error(calib, ds1307_to_epoch(ds1307_now(cache))) == 0) {
+		ds1307_unlock(calib->rtc);
+		return DS1307_OK;
+	}
+	status = DS1307_read_date_time(calib->rtc);
+	if (status != DS1307_OK) {
+		ds1307_unlock(calib->rtc);
+		return status;
+	}
+
+	step = ds1307_calib_error(calib, ds1307_to_epoch(calib->rtc));
+	if (step == 0) {
+		ds1307_unlock(calib->rtc);
+		return DS1307_OK;
+	}
+	if (calib->rtc->second >= 58U) {
+		ds1307_unlock(calib->rtc);
+		return DS1307_BUSY;
+	}
+
+	second = (int32_t) calib->rtc->second - step;
+	if (second < 0) {
+		second = 0;
+	} else if (second > 59) {
+		second = 59;
+	}
+	step = (int32_t) calib->rtc->second - second;
+
+	status = ds1307_set_second(calib->rtc, (uint8_t) second);
+	if (status == DS1307_OK) {
+		calib->stepped += step;
+		status = ds1307_calib_store(calib, calib, 9);
+	}
+	ds1307_unlock(calib->rtc);
+
+	if (cache) {
+		ds1307_status_t sync = ds1307_cache_sync(cache);
+
+		if (status == DS1307_OK) {
+			status = sync;
+		}
+	}
+	return status;
+}
+
+/**
+  * @brief  Writes a calibration state to the NVRAM region.
+  * @param  calib: Pointer to the calibration structure (context and region offset).
+  * @param  state: State to write.
+  * @param  offset: First region byte to write; the bytes from offset up to the CRC are written.
+  * @retval Status of the NVRAM write.
+  */
+static ds1307_status_t ds1307_calib_store(ds1307_calib_t *calib,
+		const ds1307_calib_t *state, uint8_t offset) {
+	uint8_t region[DS1307_CALIB_REGION_SIZE];
+
+	region[0] = DS1307_CALIB_MAGIC;
+	ds1307_calib_put32(&region[1], state->anchor);
+	ds1307_calib_put32(&region[5], (uint32_t) state->drift_ppb);
+	ds1307_calib_put32(&region[9], (uint32_t) state->stepped);
+	region[DS1307_CALIB_REGION_SIZE - 1U] = ds1307_crc8(region,
+			DS1307_CALIB_REGION_SIZE - 1U);
+	return ds1307_nvram_write(calib->rtc, (uint8_t) (calib->base + offset),
+			&region[offset], (uint8_t) (DS1307_CALIB_REGION_SIZE - offset));
+}
+
+/**
+  * @brief  Stores a 32-bit value in little-endian order.
+  * @param  p: Destination of the four bytes.
+  * @param  value: Value to store.
+  * @retval None
+  */
+static void ds1307_calib_put32(uint8_t *p, uint32_t value) {
+	p[0] = (uint8_t) value;
+	p[1] = (uint8_t) (value >> 8);
+	p[2] = (uint8_t) (value >> 16);
+	p[3] = (uint8_t) (value >> 24);
+}
+
+/**
+  * @brief  Loads a 32-bit value stored in little-endian order.
+  * @param  p: Source of the four bytes.
+  * @retval Loaded value.
+  */
+static uint32_t ds1307_calib_get32(const uint8_t *p) {
+	return (uint32_t) p[0] | ((uint32_t) p[1] << 8) | ((uint32_t) p[2] << 16)
+			| ((uint32_t) p[3] << 24);
+}
@@ -0,0 +1,100 @@
+/**
+  ******************************************************************************
+  * @file    DS1307_calib.h
+  * @author  iek2443
+  * @brief   Header file for the DS1307 drift calibration.
+  *          Contains the calibration structure and function prototypes for
+  *          measuring the crystal drift against a reference time and
+  *          correcting it in software.
+  ******************************************************************************
+  * @attention
+  *
+  * The DS1307 has no aging trim register. The drift is measured between two
+  * reference syncs (e.g. NTP or GPS), stored in NVRAM and compensated by
+  * stepping the seconds register by whole seconds.
+  *
+  * Region layout (offsets relative to the region start):
+  *   0      Magic byte
+  *   1-4    Anchor: reference time of the last measurement (little endian)
+  *   5-8    Drift in parts per billion, signed (little endian)
+  *   9-12   Seconds already stepped back since the anchor, signed (little endian)
+  *   13     CRC-8 of bytes 0-12
+  *
+  ******************************************************************************
+  */
+
+#ifndef INC_DS1307_CALIB_H_
+#define INC_DS1307_CALIB_H_
+
+#include "DS1307.h"
+#include "DS1307_cache.h"
+
+#if !DS1307_CONFIG_FIELD_API
+#error "DS1307_calib requires DS1307_CONFIG_FIELD_API (it steps the time with ds1307_set_second)"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief  Calibration layout constants.
+ */
+#define DS1307_CALIB_MAGIC			0xCAU
+#define DS1307_CALIB_REGION_SIZE	14U
+
+/**
+ * @brief  Shortest reference interval, in seconds, over which the drift is measured.
+ * @note   A sync that comes earlier only sets the time; the measurement continues to the next sync.
+ */
+#ifndef DS1307_CALIB_MIN_INTERVAL
+#define DS1307_CALIB_MIN_INTERVAL	86400UL
+#endif
+
+/**
+ * @brief  Largest drift, in parts per billion, accepted from a measurement.
+ * @note   Larger values point to a wrong reference or a time set behind the driver's back.
+ */
+#ifndef DS1307_CALIB_MAX_PPB
+#define DS1307_CALIB_MAX_PPB		500000L
+#endif
+
+/**
+ * @brief  DS1307 drift calibration structure.
+ */
+typedef struct {
+	ds1307_context_t *rtc; /*!< DS1307 context used for I2C access */
+	uint8_t base; /*!< NVRAM offset of the calibration region */
+	uint8_t anchored; /*!< Non-zero once a reference sync has set the anchor */
+	uint32_t anchor; /*!< Reference Unix timestamp the measurement started at */
+	int32_t drift_ppb; /*!< Measured drift in parts per billion (positive = device runs fast) */
+	int32_t stepped; /*!< Seconds stepped back since the anchor (negative = stepped forward) */
+} ds1307_calib_t;
+
+/**
+ * @brief  Loads the calibration stored in an NVRAM region.
+ */
+ds1307_status_t ds1307_calib_open(ds1307_calib_t *calib, ds1307_context_t *rtc,
+		uint8_t base, uint8_t *restored);
+
+/**
+ * @brief  Sets the device to a reference time and updates the drift measurement.
+ */
+ds1307_status_t ds1307_calib_sync(ds1307_calib_t *calib, uint32_t reference,
+		ds1307_cache_t *cache);
+
+/**
+ * @brief  Returns the whole seconds the device is expected to be ahead at a device time, beyond the steps already made.
+ */
+int32_t ds1307_calib_error(const ds1307_calib_t *calib, uint32_t epoch);
+
+/**
+ * @brief  Steps the seconds register by the predicted drift.
+ */
+ds1307_status_t ds1307_calib_apply(ds1307_calib_t *calib, ds1307_cache_t *cache);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_DS1307_CALIB_H_ */
@@ -0,0 +1,82 @@
+/**
+  ******************************************************************************
+  * @file    DS1307_config.h
+  * @author  iek2443
+  * @brief   Build configuration of the DS1307 RTC driver.
+  *          Contains the DS1307_CONFIG_* feature selection macros.
+  ******************************************************************************
+  * @attention
+  *
+  * Every option can be changed here or given on the compiler command line
+  * (e.g. -DDS1307_CONFIG_12H=0). All sources of one image must be built
+  * with the same values, since some options change the context structure.
+  * The defaults build the full API.
+  *
+  ******************************************************************************
+  */
+
+#ifndef INC_DS1307_CONFIG_H_
+#define INC_DS1307_CONFIG_H_
+
+/**
+ * @brief  BCD codec backends selectable through DS1307_CONFIG_CODEC.
+ */
+#define DS1307_CODEC_ARITH		0 /*!< Multiply/divide/modulo arithmetic (default) */
+#define DS1307_CODEC_LUT		1 /*!< 100-entry constant lookup table, no division */
+#define DS1307_CODEC_MULSHIFT	2 /*!< Multiply-shift reciprocal, no division and no table */
+#define DS1307_CODEC_SWAR		3 /*!< Multiply-shift, plus SWAR conversion of the whole register image */
+
+#ifndef DS1307_CONFIG_CODEC
+#define DS1307_CONFIG_CODEC		DS1307_CODEC_ARITH
+#endif
+
+/**
+ * @brief  Set DS1307_CONFIG_STATS to 1 to collect bus usage statistics in every context.
+ */
+#ifndef DS1307_CONFIG_STATS
+#define DS1307_CONFIG_STATS		0
+#endif
+
+/**
+ * @brief  Memory barrier used by the snapshot sequence lock.
+ * @note   Defaults to a full hardware barrier on GCC and Clang (a DMB on Cortex-M). Define it before
+ *         including this header on other compilers, or to a compiler-only barrier on single-core parts.
+ */
+#ifndef DS1307_BARRIER
+#if defined(__GNUC__)
+#define DS1307_BARRIER()		__sync_synchronize()
+#else
+#define DS1307_BARRIER()
+#endif
+#endif
+
+/**
+ * @brief  Set DS1307_CONFIG_12H to 0 for a 24-hour-only build.
+ * @note   The 12-hour encoding and decoding branches and @ref ds1307_set_time_format are removed.
+ *         The device is assumed to be in 24-hour layout; usr->time_format is always
+ *         DS1307_HOUR_FORMAT_24 and usr->time_period DS1307_NONE.
+ */
+#ifndef DS1307_CONFIG_12H
+#define DS1307_CONFIG_12H		1
+#endif
+
+/**
+ * @brief  Set DS1307_CONFIG_FIELD_API to 0 for a burst-only build.
+ * @note   The per-field ds1307_set_* / ds1307_get_* functions of the timekeeping registers, the
+ *         deferred write mode and @ref ds1307_commit are removed. The time is accessed with
+ *         @ref DS1307_read_date_time, @ref ds1307_read_raw and @ref ds1307_set_date_time.
+ */
+#ifndef DS1307_CONFIG_FIELD_API
+#define DS1307_CONFIG_FIELD_API	1
+#endif
+
+/**
+ * @brief  Set DS1307_CONFIG_CENTURY to 0 to drop century tracking.
+ * @note   The context has no century field and the year is always 2000 + the year register.
+ *         Use @ref DS1307_CENTURY to read the century of a context in both builds.
+ */
+#ifndef DS1307_CONFIG_CENTURY
+#define DS1307_CONFIG_CENTURY	1
+#endif
+
+#endif /* INC_DS1307_CONFIG_H_ */
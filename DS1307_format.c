@@ -0,0 +1,201 @@
+/**
+  ******************************************************************************
+  * @file    DS1307_format.c
+  * @author  iek2443
+  * @brief   Source file for the DS1307 timestamp formatter.
+  *          Writes ISO-8601 and log timestamps into caller buffers straight
+  *          from the BCD nibbles of the raw register image.
+  ******************************************************************************
+  * @attention
+  *
+  * The formatters read usr->regs and make no I2C access. The driver keeps
+  * that image in step with the date and time fields on every path that
+  * changes them: the reads, the setters, ds1307_set_date_time,
+  * ds1307_compact_unpack and ds1307_from_epoch, and so ds1307_add_seconds,
+  * ds1307_tick and the cached clock of DS1307_cache. Fields assigned by
+  * hand reach usr->regs with ds1307_set_date_time.
+  * Layout: "YYYY-MM-DDTHH:MM:SS"
+  *          0123456789012345678
+  *
+  ******************************************************************************
+  */
+#include "DS1307_format.h"
+
+static void ds1307_format_text(const uint8_t *regs, uint16_t century,
+		char separator, char *buf);
+static void ds1307_format_bcd(char *p, uint8_t bcd);
+static void ds1307_format_century(char *p, uint16_t century);
+static uint8_t ds1307_format_hour(uint8_t hour);
+
+/**
+  * @brief  Formats the raw image of the context as an ISO-8601 timestamp.
+  * @param  usr: Pointer to the DS1307 context structure holding the raw image.
+  * @param  buf: Destination buffer of at least DS1307_ISO8601_SIZE bytes.
+  * @retval None
+  * @note   A 12-hour register layout is converted, so the hour is always written in 24-hour format.
+  */
+void ds1307_format_iso8601(const ds1307_context_t *usr, char *buf) {
+	ds1307_format_text(usr->regs, DS1307_CENTURY(usr), 'T', buf);
+}
+
+/**
+  * @brief  Formats the raw image of the context as a log timestamp.
+  * @param  usr: Pointer to the DS1307 context structure holding the raw image.
+  * @param  buf: Destination buffer of at least DS1307_ISO8601_SIZE bytes.
+  * @retval None
+  * @note   Same as @ref ds1307_format_iso8601 with a space instead of the 'T' separator.
+  */
+void ds1307_format_log(const ds1307_context_t *usr, char *buf) {
+	ds1307_format_text(usr->regs, DS1307_CENTURY(usr), ' ', buf);
+}
+
+/**
+  * @brief  Formats a compact timestamp as an ISO-8601 timestamp.
+  * @param  time: Pointer to the compact timestamp.
+  * @param  buf: Destination buffer of at least DS1307_ISO8601_SIZE bytes.
+  * @retval None
+  */
+void ds1307_compact_format_iso8601(const ds1307_compact_t *time, char *buf) {
+	ds1307_format_text(time->regs, (uint16_t) time->century * 100U, 'T', buf);
+}
+
+/**
+  * @brief  Initializes an incremental formatter.
+  * @param  fmt: Pointer to the formatter structure.
+  * @param  separator: Character written between the date and the time (e.g. 'T' or ' ').
+  * @retval None
+  */
+void ds1307_iso8601_init(ds1307_iso8601_t *fmt, char separator) {
+	fmt->text[10] = separator;
+	fmt->valid = 0;
+}
+
+/**
+  * @brief  Updates the incremental formatter from the raw image of the context.
+  * @param  fmt: Pointer to the formatter structure.
+  * @param  usr: Pointer to the DS1307 context structure holding the raw image.
+  * @retval Pointer to the formatted NUL-terminated text, valid until the next update.
+  * @note   The first update formats the whole text. Later updates only compare the seven
+  *         register bytes and rewrite the two digits of each register that changed; with one
+  *         update per second this is usually just the seconds.
+  */
+const char* ds1307_iso8601_update(ds1307_iso8601_t *fmt,
+		const ds1307_context_t *usr) {
+	const uint8_t *regs = usr->regs;
+	uint8_t i;
+
+	if (!fmt->valid || fmt->century != DS1307_CENTURY(usr)) {
+		ds1307_format_text(regs, DS1307_CENTURY(usr), fmt->text[10], fmt->text);
+	} else {
+		if (fmt->regs[DS1307_SEC_REG_ADR] != regs[DS1307_SEC_REG_ADR]) {
+			ds1307_format_bcd(&fmt->text[17], regs[DS1307_SEC_REG_ADR] & 0x7FU);
+		}
+		if (fmt->regs[DS1307_MIN_REG_ADR] != regs[DS1307_MIN_REG_ADR]) {
+			ds1307_format_bcd(&fmt->text[14], regs[DS1307_MIN_REG_ADR]);
+		}
+		if (fmt->regs[DS1307_HOUR_REG_ADR] != regs[DS1307_HOUR_REG_ADR]) {
+			ds1307_format_bcd(&fmt->text[11],
+					ds1307_format_hour(regs[DS1307_HOUR_REG_ADR]));
+		}
+		if (fmt->regs[DS1307_DATE_REG_ADR] != regs[DS1307_DATE_REG_ADR]) {
+			ds1307_format_bcd(&fmt->text[8], regs[DS1307_DATE_REG_ADR]);
+		}
+		if (fmt->regs[DS1307_MONTH_REG_ADR] != regs[DS1307_MONTH_REG_ADR]) {
+			ds1307_format_bcd(&fmt->text[5], regs[DS1307_MONTH_REG_ADR]);
+		}
+		if (fmt->regs[DS1307_YEAR_REG_ADR] != regs[DS1307_YEAR_REG_ADR]) {
+			ds1307_format_bcd(&fmt->text[2], regs[DS1307_YEAR_REG_ADR]);
+		}
+	}
+	for (i = 0; i < DS1307_TIME_REG_COUNT; i++) {
+		fmt->regs[i] = regs[i];
+	}
+	fmt->century = DS1307_CENTURY(usr);
+	fmt->valid = 1;
+	return fmt->text;
+}
+
+/**
+  * @brief  Formats a full timestamp from a raw register image.
+  * @param  regs: Raw register image starting at @ref DS1307_SEC_REG_ADR.
+  * @param  century: Century offset (e.g., 2000).
+  * @param  separator: Character written between the date and the time.
+  * @param  buf: Destination buffer of at least DS1307_ISO8601_SIZE bytes.
+  * @retval None
+  */
+static void ds1307_format_text(const uint8_t *regs, uint16_t century,
+		char separator, char *buf) {
+	ds1307_format_century(&buf[0], century);
+	ds1307_format_bcd(&buf[2], regs[DS1307_YEAR_REG_ADR]);
+	buf[4] = '-';
+	ds1307_format_bcd(&buf[5], regs[DS1307_MONTH_REG_ADR]);
+	buf[7] = '-';
+	ds1307_format_bcd(&buf[8], regs[DS1307_DATE_REG_ADR]);
+	buf[10] = separator;
+	ds1307_format_bcd(&buf[11], ds1307_format_hour(regs[DS1307_HOUR_REG_ADR]));
+	buf[13] = ':';
+	ds1307_format_bcd(&buf[14], regs[DS1307_MIN_REG_ADR]);
+	buf[16] = ':';
+	ds1307_format_bcd(&buf[17], regs[DS1307_SEC_REG_ADR] & 0x7FU);
+	buf[19] = '\0';
+}
+
+/**
+  * @brief  Writes the two digits of a BCD byte.
+  * @param  p: Destination of the two characters.
+  * @param  bcd: BCD value.
+  * @retval None
+  */
+static void ds1307_format_bcd(char *p, uint8_t bcd) {
+	p[0] = (char) ('0' + (bcd >> 4));
+	p[1] = (char) ('0' + (bcd & 0x0FU));
+}
+
+/**
+  * @brief  Writes the two leading digits of the year from the century offset.
+  * @param  p: Destination of the two characters.
+  * @param  century: Century offset (a multiple of 100, up to 9900).
+  * @retval None
+  * @note   Uses repeated subtraction instead of division (at most 18 steps).
+  */
+static void ds1307_format_century(char *p, uint16_t century) {
+	uint8_t thousands = 0;
+	uint8_t hundreds = 0;
+
+	while (century >= 1000U && thousands < 9U) {
+		century -= 1000U;
+		thousands++;
+	}
+	while (century >= 100U && hundreds < 9U) {
+		century -= 100U;
+		hundreds++;
+	}
+	p[0] = (char) ('0' + thousands);
+	p[1] = (char) ('0' + hundreds);
+}
+
+/**
+  * @brief  Returns the hours register as a 24-hour BCD value.
+  * @param  hour: Raw hours register, in 12-hour or 24-hour layout.
+  * @retval Hour in 24-hour format, BCD encoded.
+  * @note   The 24-hour layout is returned as is. In 12-hour layout 12 AM becomes 00 and PM hours
+  *         get 12 added, using BCD digit adjustment only.
+  */
+static uint8_t ds1307_format_hour(uint8_t hour) {
+	uint8_t value;
+
+	if (!DS1307_CONFIG_12H || !(hour & 0x40U)) {
+		return hour & 0x3FU;
+	}
+	value = hour & 0x1FU;
+	if (value == 0x12U) {
+		value = 0;
+	}
+	if (hour & 0x20U) {
+		value += 0x12U;
+		if ((value & 0x0FU) > 9U) {
+			value += 6U;
+		}
+	}
+	return value;
+}
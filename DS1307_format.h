@@ -0,0 +1,73 @@
+/**
+  ******************************************************************************
+  * @file    DS1307_format.h
+  * @author  iek2443
+  * @brief   Header file for the DS1307 timestamp formatter.
+  *          Contains the incremental formatter structure and function
+  *          prototypes for writing ISO-8601 and log timestamps.
+  ******************************************************************************
+  * @attention
+  *
+  * The DS1307 registers hold one BCD digit per nibble, so the text is built
+  * directly from the raw register image without division, stdio or heap.
+  *
+  ******************************************************************************
+  */
+
+#ifndef INC_DS1307_FORMAT_H_
+#define INC_DS1307_FORMAT_H_
+
+#include "DS1307.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief  Buffer size of a formatted timestamp "YYYY-MM-DDTHH:MM:SS", including the terminating NUL.
+ */
+#define DS1307_ISO8601_SIZE		20U
+
+/**
+ * @brief  Incremental formatter state.
+ * @note   Holds the last formatted text and the register image it was built from, so that an
+ *         update only rewrites the digits of the registers that changed.
+ */
+typedef struct {
+	char text[DS1307_ISO8601_SIZE]; /*!< Formatted timestamp, NUL-terminated */
+	uint8_t regs[DS1307_TIME_REG_COUNT]; /*!< Raw register image of the last update */
+	uint16_t century; /*!< Century of the last update */
+	uint8_t valid; /*!< Non-zero once text has been formatted */
+} ds1307_iso8601_t;
+
+/**
+ * @brief  Formats the raw image of the context as "YYYY-MM-DDTHH:MM:SS".
+ */
+void ds1307_format_iso8601(const ds1307_context_t *usr, char *buf);
+
+/**
+ * @brief  Formats the raw image of the context as "YYYY-MM-DD HH:MM:SS" for log lines.
+ */
+void ds1307_format_log(const ds1307_context_t *usr, char *buf);
+
+/**
+ * @brief  Formats a compact timestamp as "YYYY-MM-DDTHH:MM:SS".
+ */
+void ds1307_compact_format_iso8601(const ds1307_compact_t *time, char *buf);
+
+/**
+ * @brief  Initializes an incremental formatter with the date/time separator ('T' or ' ').
+ */
+void ds1307_iso8601_init(ds1307_iso8601_t *fmt, char separator);
+
+/**
+ * @brief  Updates the incremental formatter from the raw image of the context, rewriting only changed digits.
+ */
+const char* ds1307_iso8601_update(ds1307_iso8601_t *fmt,
+		const ds1307_context_t *usr);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_DS1307_FORMAT_H_ */
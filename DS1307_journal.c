@@ -0,0 +1,210 @@
+/**
+  ******************************************************************************
+  * @file    DS1307_journal.c
+  * @author  iek2443
+  * @brief   Source file for the DS1307 NVRAM journal.
+  *          Implements an append-only ring buffer of CRC-protected records in
+  *          the battery-backed RAM of the DS1307.
+  ******************************************************************************
+  * @attention
+  *
+  * An append writes the record into the slot at the head index first and the
+  * header afterwards. While the journal is filling up that slot is unused, so
+  * a power loss in between only drops the new record. Once the journal is
+  * full the slot holds the oldest record, which is overwritten before the
+  * header moves: a power loss in between loses that record, and the slot is
+  * reported as the oldest record, holding the new record, or failing its CRC
+  * if the write was cut short. The other records are never touched.
+  *
+  ******************************************************************************
+  */
+#include "DS1307_journal.h"
+
+static uint8_t ds1307_journal_slot(const ds1307_journal_t *journal,
+		uint8_t slot);
+
+/**
+  * @brief  Opens the journal stored in an NVRAM region.
+  * @param  journal: Pointer to the journal structure to initialize.
+  * @param  rtc: Pointer to the configured DS1307 context structure.
+  * @param  base: NVRAM offset of the journal region.
+  * @param  size: Size of the journal region in bytes (header plus at least one record).
+  * @param  recovered: Optional pointer set to non-zero if an existing journal was recovered and to zero
+  *                    if the region was formatted (may be NULL).
+  * @retval Status of the NVRAM access, @ref DS1307_INVALID_PARAM if the region overlaps the
+  *         @ref ds1307_init marker.
+  * @note   The header is read in one transfer. A region without a valid header is formatted.
+  *         Nothing is formatted if the header cannot be read.
+  */
+ds1307_status_t ds1307_journal_open(ds1307_journal_t *journal,
+		ds1307_context_t *rtc, uint8_t base, uint8_t size, uint8_t *recovered) {
+	uint8_t header[DS1307_JOURNAL_HEADER_SIZE];
+	ds1307_status_t status;
+
+	if (base < DS1307_INIT_MAGIC_SIZE) {
+		return DS1307_INVALID_PARAM;
+	}
+	journal->rtc = rtc;
+	journal->base = base;
+	journal->capacity = (size > DS1307_JOURNAL_HEADER_SIZE) ?
+			(uint8_t) ((size - DS1307_JOURNAL_HEADER_SIZE)
+					/ DS1307_JOURNAL_RECORD_SIZE) : 0U;
+
+	journal->head = 0;
+	journal->count = 0;
+	if (recovered) {
+		*recovered = 0;
+	}
+
+	status = ds1307_nvram_read(rtc, base, header, DS1307_JOURNAL_HEADER_SIZE);
+	if (status != DS1307_OK) {
+		return status;
+	}
+	if (header[0] == DS1307_JOURNAL_MAGIC && header[1] < journal->capacity
+			&& header[2] <= journal->capacity) {
+		journal->head = header[1];
+		journal->count = header[2];
+		if (recovered) {
+			*recovered = 1;
+		}
+		return DS1307_OK;
+	}
+
+	return ds1307_journal_clear(journal);
+}
+
+/**
+  * @brief  Erases all records of the journal.
+  * @param  journal: Pointer to the journal structure.
+  * @retval Status of the NVRAM write.
+  * @note   Only the header is rewritten.
+  */
+ds1307_status_t ds1307_journal_clear(ds1307_journal_t *journal) {
+	uint8_t header[DS1307_JOURNAL_HEADER_SIZE] = { DS1307_JOURNAL_MAGIC, 0, 0 };
+
+	journal->head = 0;
+	journal->count = 0;
+	return ds1307_nvram_write(journal->rtc, journal->base, header,
+			DS1307_JOURNAL_HEADER_SIZE);
+}
+
+/**
+  * @brief  Appends a record to the journal.
+  * @param  journal: Pointer to the journal structure.
+  * @param  epoch: Unix timestamp of the event.
+  * @param  code: User-defined event or fault code.
+  * @retval Status of the NVRAM writes, @ref DS1307_INVALID_PARAM if the journal has no capacity.
+  * @note   When the journal is full the oldest record is overwritten. An append costs one record
+  *         write plus one header write of only the bytes that changed (the head index, and the
+  *         record count while the journal is filling up). The journal state is only advanced when
+  *         both writes succeed; if the header write fails on a full journal, the oldest record is
+  *         already replaced (see the file header). The bus lock of the context is held across
+  *         both writes.
+  */
+ds1307_status_t ds1307_journal_append(ds1307_journal_t *journal,
+		uint32_t epoch, uint8_t code) {
+	uint8_t record[DS1307_JOURNAL_RECORD_SIZE];
+	uint8_t header[2];
+	ds1307_status_t status;
+
+	if (journal->capacity == 0) {
+		return DS1307_INVALID_PARAM;
+	}
+	record[0] = (uint8_t) epoch;
+	record[1] = (uint8_t) (epoch >> 8);
+	record[2] = (uint8_t) (epoch >> 16);
+	record[3] = (uint8_t) (epoch >> 24);
+	record[4] = code;
+	record[5] = ds1307_crc8(record, DS1307_JOURNAL_RECORD_SIZE - 1U);
+	ds1307_lock(journal->rtc);
+	status = ds1307_nvram_write(journal->rtc,
+			ds1307_journal_slot(journal, journal->head), record,
+			DS1307_JOURNAL_RECORD_SIZE);
+	if (status != DS1307_OK) {
+		ds1307_unlock(journal->rtc);
+		return status;
+	}
+
+	header[0] = (uint8_t) (journal->head + 1U);
+	if (header[0] >= journal->capacity) {
+		header[0] = 0;
+	}
+	if (journal->count < journal->capacity) {
+		header[1] = (uint8_t) (journal->count + 1U);
+		status = ds1307_nvram_write(journal->rtc, journal->base + 1U, header, 2);
+	} else {
+		header[1] = journal->count;
+		status = ds1307_nvram_write(journal->rtc, journal->base + 1U, header, 1);
+	}
+	if (status == DS1307_OK) {
+		journal->head = header[0];
+		journal->count = header[1];
+	}
+	ds1307_unlock(journal->rtc);
+	return status;
+}
+
+/**
+  * @brief  Reads the current time from the DS1307 device and appends a record with it.
+  * @param  journal: Pointer to the journal structure.
+  * @param  code: User-defined event or fault code.
+  * @retval Status of the first failing access, or @ref DS1307_OK.
+  * @note   Nothing is appended if the time cannot be read.
+  */
+ds1307_status_t ds1307_journal_log(ds1307_journal_t *journal, uint8_t code) {
+	ds1307_status_t status = DS1307_read_date_time(journal->rtc);
+
+	if (status != DS1307_OK) {
+		return status;
+	}
+	return ds1307_journal_append(journal, ds1307_to_epoch(journal->rtc), code);
+}
+
+/**
+  * @brief  Reads a record from the journal.
+  * @param  journal: Pointer to the journal structure.
+  * @param  index: Record index, 0 being the oldest record.
+  * @param  record: Pointer to the structure where the record will be stored.
+  * @retval @ref DS1307_OK if the record was read, @ref DS1307_INVALID_PARAM if the index is out of range,
+  *         @ref DS1307_INVALID_DATA if the stored CRC does not match, otherwise the status of the NVRAM read.
+  */
+ds1307_status_t ds1307_journal_read(ds1307_journal_t *journal, uint8_t index,
+		ds1307_journal_record_t *record) {
+	uint8_t raw[DS1307_JOURNAL_RECORD_SIZE];
+	ds1307_status_t status;
+	uint16_t slot;
+
+	if (index >= journal->count) {
+		return DS1307_INVALID_PARAM;
+	}
+	slot = (uint16_t) journal->head + journal->capacity - journal->count + index;
+	if (slot >= journal->capacity) {
+		slot -= journal->capacity;
+	}
+	status = ds1307_nvram_read(journal->rtc,
+			ds1307_journal_slot(journal, (uint8_t) slot), raw,
+			DS1307_JOURNAL_RECORD_SIZE);
+	if (status != DS1307_OK) {
+		return status;
+	}
+	if (ds1307_crc8(raw, DS1307_JOURNAL_RECORD_SIZE - 1U)
+			!= raw[DS1307_JOURNAL_RECORD_SIZE - 1U]) {
+		return DS1307_INVALID_DATA;
+	}
+	record->epoch = (uint32_t) raw[0] | ((uint32_t) raw[1] << 8)
+			| ((uint32_t) raw[2] << 16) | ((uint32_t) raw[3] << 24);
+	record->code = raw[4];
+	return DS1307_OK;
+}
+
+/**
+  * @brief  Returns the NVRAM offset of a record slot.
+  * @param  journal: Pointer to the journal structure.
+  * @param  slot: Slot index (0 to capacity - 1).
+  * @retval NVRAM offset of the slot.
+  */
+static uint8_t ds1307_journal_slot(const ds1307_journal_t *journal,
+		uint8_t slot) {
+	return (uint8_t) (journal->base + DS1307_JOURNAL_HEADER_SIZE
+			+ slot * DS1307_JOURNAL_RECORD_SIZE);
+}
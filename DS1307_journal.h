@@ -0,0 +1,88 @@
+/**
+  ******************************************************************************
+  * @file    DS1307_journal.h
+  * @author  iek2443
+  * @brief   Header file for the DS1307 NVRAM journal.
+  *          Contains the journal structures and function prototypes for a
+  *          CRC-protected ring buffer of breadcrumbs in battery-backed RAM.
+  ******************************************************************************
+  * @attention
+  *
+  * Region layout (offsets relative to the region start):
+  *   0      Magic byte
+  *   1      Head index (next slot to write)
+  *   2      Number of valid records
+  *   3...   Records of DS1307_JOURNAL_RECORD_SIZE bytes:
+  *          epoch (4 bytes, little endian), code (1 byte), CRC-8 (1 byte)
+  *
+  ******************************************************************************
+  */
+
+#ifndef INC_DS1307_JOURNAL_H_
+#define INC_DS1307_JOURNAL_H_
+
+#include "DS1307.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief  Journal layout constants.
+ */
+#define DS1307_JOURNAL_MAGIC		0xB5U
+#define DS1307_JOURNAL_HEADER_SIZE	3U
+#define DS1307_JOURNAL_RECORD_SIZE	6U
+
+/**
+ * @brief  Journal record.
+ */
+typedef struct {
+	uint32_t epoch; /*!< Unix timestamp of the event */
+	uint8_t code; /*!< User-defined event or fault code */
+} ds1307_journal_record_t;
+
+/**
+ * @brief  DS1307 NVRAM journal structure.
+ */
+typedef struct {
+	ds1307_context_t *rtc; /*!< DS1307 context used for I2C access and timestamps */
+	uint8_t base; /*!< NVRAM offset of the journal region */
+	uint8_t capacity; /*!< Number of record slots in the region */
+	uint8_t head; /*!< Next slot to write */
+	uint8_t count; /*!< Number of valid records */
+} ds1307_journal_t;
+
+/**
+ * @brief  Opens the journal stored in an NVRAM region, formatting it if no valid journal is found.
+ */
+ds1307_status_t ds1307_journal_open(ds1307_journal_t *journal,
+		ds1307_context_t *rtc, uint8_t base, uint8_t size, uint8_t *recovered);
+
+/**
+ * @brief  Erases all records of the journal.
+ */
+ds1307_status_t ds1307_journal_clear(ds1307_journal_t *journal);
+
+/**
+ * @brief  Appends a record with an explicit timestamp.
+ */
+ds1307_status_t ds1307_journal_append(ds1307_journal_t *journal,
+		uint32_t epoch, uint8_t code);
+
+/**
+ * @brief  Reads the current time from the DS1307 and appends a record with it.
+ */
+ds1307_status_t ds1307_journal_log(ds1307_journal_t *journal, uint8_t code);
+
+/**
+ * @brief  Reads a record; index 0 is the oldest one.
+ */
+ds1307_status_t ds1307_journal_read(ds1307_journal_t *journal, uint8_t index,
+		ds1307_journal_record_t *record);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_DS1307_JOURNAL_H_ */
@@ -0,0 +1,312 @@
+/**
+  ******************************************************************************
+  * @file    DS1307_linux.c
+  * @author  iek2443
+  * @brief   Source file for the DS1307 Linux i2c-dev transport.
+  *          Implements the driver transport functions and message batches on
+  *          top of the I2C_RDWR ioctl.
+  ******************************************************************************
+  * @attention
+  *
+  * Addresses are given in the 8-bit form used by the driver (R/W bit
+  * included, e.g. DS1307_WRITE_ADR) and are shifted to the 7-bit form of
+  * the kernel. The adapter must support I2C_FUNC_I2C (plain SMBus-only
+  * adapters do not support I2C_RDWR).
+  *
+  ******************************************************************************
+  */
+#define _POSIX_C_SOURCE 200809L
+
+#include "DS1307_linux.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <linux/i2c-dev.h>
+
+static ds1307_status_t ds1307_linux_transfer(ds1307_linux_bus_t *bus,
+		struct i2c_msg *msgs, uint32_t count);
+static ds1307_status_t ds1307_linux_status(int error);
+
+/**
+  * @brief  Opens an i2c-dev device.
+  * @param  bus: Pointer to the bus structure to initialize.
+  * @param  path: Path of the device node, e.g. "/dev/i2c-1".
+  * @retval @ref DS1307_OK, or the status mapped from errno if the device cannot be opened.
+  */
+ds1307_status_t ds1307_linux_open(ds1307_linux_bus_t *bus, const char *path) {
+	bus->fd = open(path, O_RDWR);
+	if (bus->fd < 0) {
+		return ds1307_linux_status(errno);
+	}
+	return DS1307_OK;
+}
+
+/**
+  * @brief  Closes the i2c-dev device.
+  * @param  bus: Pointer to the bus structure.
+  * @retval None
+  */
+void ds1307_linux_close(ds1307_linux_bus_t *bus) {
+	if (bus->fd >= 0) {
+		close(bus->fd);
+		bus->fd = -1;
+	}
+}
+
+/**
+  * @brief  Sets the transport functions and the handle of a driver configuration to the bus.
+  * @param  functions: Pointer to the driver configuration (e.g. &ds1307.functions).
+  * @param  bus: Pointer to an opened bus structure.
+  * @retval None
+  * @note   The asynchronous transport and the other fields are left unchanged.
+  */
+void ds1307_linux_bind(ds1307_user_func_t *functions, ds1307_linux_bus_t *bus) {
+	functions->ds1307_i2c_send_ptr = ds1307_linux_write;
+	functions->ds1307_i2c_read_ptr = ds1307_linux_read;
+	functions->handle = bus;
+	functions->max_transfer_size = DS1307_LINUX_MAX_TRANSFER;
+}
+
+/**
+  * @brief  Writes data to consecutive registers in one ioctl.
+  * @param  handle: Pointer to the bus structure.
+  * @param  address: 8-bit I2C address of the device.
+  * @param  reg_adr: First register address.
+  * @param  data: Data to write.
+  * @param  size: Number of bytes (up to DS1307_LINUX_MAX_TRANSFER).
+  * @retval Status of the transfer, @ref DS1307_INVALID_PARAM if size is too large.
+  * @note   The register address and the data are sent as one message.
+  */
+ds1307_status_t ds1307_linux_write(void *handle, ds1307_adr_t address,
+		ds1307_reg_adr_t reg_adr, uint8_t *data, uint16_t size) {
+	uint8_t buffer[1U + DS1307_LINUX_MAX_TRANSFER];
+	struct i2c_msg msg;
+
+	if (size > DS1307_LINUX_MAX_TRANSFER) {
+		return DS1307_INVALID_PARAM;
+	}
+	buffer[0] = (uint8_t) reg_adr;
+	memcpy(&buffer[1], data, size);
+
+	msg.addr = (uint16_t) ((uint8_t) address >> 1);
+	msg.flags = 0;
+	msg.len = (uint16_t) (size + 1U);
+	msg.buf = buffer;
+	return ds1307_linux_transfer((ds1307_linux_bus_t*) handle, &msg, 1);
+}
+
+/**
+  * @brief  Reads data from consecutive registers in one ioctl.
+  * @param  handle: Pointer to the bus structure.
+  * @param  address: 8-bit I2C address of the device.
+  * @param  reg_adr: First register address.
+  * @param  data: Destination buffer.
+  * @param  size: Number of bytes.
+  * @retval Status of the transfer.
+  * @note   The register pointer write and the data read are joined with a repeated start, so
+  *         no other master can move the register pointer in between.
+  */
+ds1307_status_t ds1307_linux_read(void *handle, ds1307_adr_t address,
+		ds1307_reg_adr_t reg_adr, uint8_t *data, uint16_t size) {
+	uint8_t reg = (uint8_t) reg_adr;
+	struct i2c_msg msgs[2];
+
+	msgs[0].addr = (uint16_t) ((uint8_t) address >> 1);
+	msgs[0].flags = 0;
+	msgs[0].len = 1;
+	msgs[0].buf = &reg;
+	msgs[1].addr = msgs[0].addr;
+	msgs[1].flags = I2C_M_RD;
+	msgs[1].len = size;
+	msgs[1].buf = data;
+	return ds1307_linux_transfer((ds1307_linux_bus_t*) handle, msgs, 2);
+}
+
+/**
+  * @brief  Initializes a batch.
+  * @param  batch: Pointer to the batch structure to initialize.
+  * @param  bus: Pointer to an opened bus structure.
+  * @param  msgs: User-provided message table (at most I2C_RDWR_IOCTL_MAX_MSGS entries are sent).
+  * @param  capacity: Number of entries in the message table.
+  * @param  buffer: User-provided buffer holding the register addresses and the write data.
+  * @param  buffer_size: Size of the buffer in bytes.
+  * @retval None
+  */
+void ds1307_linux_batch_init(ds1307_linux_batch_t *batch,
+		ds1307_linux_bus_t *bus, struct i2c_msg *msgs, uint8_t capacity,
+		uint8_t *buffer, uint16_t buffer_size) {
+	batch->bus = bus;
+	batch->msgs = msgs;
+	batch->capacity = capacity;
+	batch->count = 0;
+	batch->buffer = buffer;
+	batch->buffer_size = buffer_size;
+	batch->used = 0;
+	batch->stop_count = 0;
+}
+
+/**
+  * @brief  Queues a register write.
+  * @param  batch: Pointer to the batch structure.
+  * @param  address: 8-bit I2C address of the device.
+  * @param  reg_adr: First register address.
+  * @param  data: Data to write, copied into the batch buffer.
+  * @param  size: Number of bytes.
+  * @retval 1 on success, 0 if the message table or the buffer is full.
+  */
+uint8_t ds1307_linux_batch_write(ds1307_linux_batch_t *batch,
+		uint8_t address, ds1307_reg_adr_t reg_adr, const uint8_t *data,
+		uint16_t size) {
+	struct i2c_msg *msg;
+
+	if (batch->count >= batch->capacity
+			|| (uint32_t) batch->used + size + 1U > batch->buffer_size) {
+		return 0;
+	}
+	msg = &batch->msgs[batch->count++];
+	msg->addr = (uint16_t) (address >> 1);
+	msg->flags = 0;
+	msg->len = (uint16_t) (size + 1U);
+	msg->buf = &batch->buffer[batch->used];
+	msg->buf[0] = (uint8_t) reg_adr;
+	memcpy(&msg->buf[1], data, size);
+	batch->used = (uint16_t) (batch->used + size + 1U);
+	return 1;
+}
+
+/**
+  * @brief  Queues a write of raw bytes without a register address.
+  * @param  batch: Pointer to the batch structure.
+  * @param  address: 8-bit I2C address of the device.
+  * @param  data: Data to write, copied into the batch buffer.
+  * @param  size: Number of bytes.
+  * @retval 1 on success, 0 if the message table, the buffer or the stop table is full.
+  * @note   Used for devices without a register pointer, such as the control byte of a PCA9548A
+  *         multiplexer. The multiplexer switches its channel only at the STOP condition that
+  *         follows the control byte, so the message ends its ioctl: @ref ds1307_linux_batch_run
+  *         sends the messages queued after it in the next one.
+  */
+uint8_t ds1307_linux_batch_raw(ds1307_linux_batch_t *batch, uint8_t address,
+		const uint8_t *data, uint16_t size) {
+	struct i2c_msg *msg;
+
+	if (batch->count >= batch->capacity
+			|| batch->stop_count >= DS1307_LINUX_BATCH_STOPS
+			|| (uint32_t) batch->used + size > batch->buffer_size) {
+		return 0;
+	}
+	msg = &batch->msgs[batch->count++];
+	msg->addr = (uint16_t) (address >> 1);
+	msg->flags = 0;
+	msg->len = size;
+	msg->buf = &batch->buffer[batch->used];
+	memcpy(msg->buf, data, size);
+	batch->used = (uint16_t) (batch->used + size);
+	batch->stops[batch->stop_count++] = batch->count;
+	return 1;
+}
+
+/**
+  * @brief  Queues a register read.
+  * @param  batch: Pointer to the batch structure.
+  * @param  address: 8-bit I2C address of the device.
+  * @param  reg_adr: First register address.
+  * @param  data: Destination buffer, filled by @ref ds1307_linux_batch_run.
+  * @param  size: Number of bytes.
+  * @retval 1 on success, 0 if the message table or the buffer is full.
+  * @note   Takes two messages: the register pointer write and the read.
+  */
+uint8_t ds1307_linux_batch_read(ds1307_linux_batch_t *batch, uint8_t address,
+		ds1307_reg_adr_t reg_adr, uint8_t *data, uint16_t size) {
+	struct i2c_msg *msg;
+
+	if (batch->count + 2U > batch->capacity
+			|| batch->used + 1U > batch->buffer_size) {
+		return 0;
+	}
+	msg = &batch->msgs[batch->count];
+	msg[0].addr = (uint16_t) (address >> 1);
+	msg[0].flags = 0;
+	msg[0].len = 1;
+	msg[0].buf = &batch->buffer[batch->used++];
+	msg[0].buf[0] = (uint8_t) reg_adr;
+	msg[1].addr = msg[0].addr;
+	msg[1].flags = I2C_M_RD;
+	msg[1].len = size;
+	msg[1].buf = data;
+	batch->count = (uint8_t) (batch->count + 2U);
+	return 1;
+}
+
+/**
+  * @brief  Sends all queued messages and empties the batch.
+  * @param  batch: Pointer to the batch structure.
+  * @retval Status of the first failed ioctl, @ref DS1307_OK if all succeeded or the batch is empty.
+  * @note   Each raw write ends an ioctl; the messages up to it are sent as one combined
+  *         transaction with repeated starts, closed by a STOP. A batch without raw writes costs
+  *         one ioctl, one with n raw writes at most n + 1. The ioctls are sent in order and
+  *         the run stops at the first failure, so the read buffers are valid on success only.
+  */
+ds1307_status_t ds1307_linux_batch_run(ds1307_linux_batch_t *batch) {
+	ds1307_status_t status = DS1307_OK;
+	uint8_t start = 0;
+	uint8_t end;
+	uint8_t i;
+
+	for (i = 0; i <= batch->stop_count && status == DS1307_OK; i++) {
+		end = (i < batch->stop_count) ? batch->stops[i] : batch->count;
+		if (end > start) {
+			status = ds1307_linux_transfer(batch->bus, &batch->msgs[start],
+					(uint32_t) (end - start));
+		}
+		start = end;
+	}
+	batch->count = 0;
+	batch->used = 0;
+	batch->stop_count = 0;
+	return status;
+}
+
+/**
+  * @brief  Sends messages in one I2C_RDWR ioctl.
+  * @param  bus: Pointer to the bus structure.
+  * @param  msgs: Messages to send.
+  * @param  count: Number of messages.
+  * @retval Status of the transfer.
+  */
+static ds1307_status_t ds1307_linux_transfer(ds1307_linux_bus_t *bus,
+		struct i2c_msg *msgs, uint32_t count) {
+	struct i2c_rdwr_ioctl_data rdwr;
+
+	if (count > I2C_RDWR_IOCTL_MAX_MSGS) {
+		return DS1307_INVALID_PARAM;
+	}
+	rdwr.msgs = msgs;
+	rdwr.nmsgs = count;
+	if (ioctl(bus->fd, I2C_RDWR, &rdwr) < 0) {
+		return ds1307_linux_status(errno);
+	}
+	return DS1307_OK;
+}
+
+/**
+  * @brief  Maps an errno value to a driver status.
+  * @param  error: errno value of the failed call.
+  * @retval Driver status.
+  */
+static ds1307_status_t ds1307_linux_status(int error) {
+	switch (error) {
+	case EAGAIN:
+	case EBUSY:
+		return DS1307_BUSY;
+	case ETIMEDOUT:
+		return DS1307_TIMEOUT;
+	case EINVAL:
+		return DS1307_INVALID_PARAM;
+	default:
+		return DS1307_ERROR;
+	}
+}
@@ -0,0 +1,131 @@
+/**
+  ******************************************************************************
+  * @file    DS1307_linux.h
+  * @author  iek2443
+  * @brief   Header file for the DS1307 Linux i2c-dev transport.
+  *          Contains the bus and batch structures and function prototypes of
+  *          a reference transport for Linux userspace.
+  ******************************************************************************
+  * @attention
+  *
+  * Every transfer is one I2C_RDWR ioctl: a register read is the pointer
+  * write and the data read combined with a repeated start, so it costs one
+  * syscall and no I2C_SLAVE setup. A batch queues the messages of several
+  * transfers and sends them in as few ioctls as the bus allows. Messages of
+  * one ioctl are joined with repeated starts, but a multiplexer such as the
+  * PCA9548A only switches its channel at the STOP after the control byte,
+  * so every raw write (@ref ds1307_linux_batch_raw) ends its ioctl and the
+  * messages behind it go into the next one. Reads of devices on the same
+  * channel, or on a bus without multiplexer, share one ioctl.
+  *
+  ******************************************************************************
+  */
+
+#ifndef INC_DS1307_LINUX_H_
+#define INC_DS1307_LINUX_H_
+
+#include "DS1307.h"
+
+#include <linux/i2c.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief  Largest data size of one transfer (the DS1307 address space).
+ */
+#define DS1307_LINUX_MAX_TRANSFER	64U
+
+/**
+ * @brief  Largest number of raw writes (ioctl splits) queued in one batch.
+ */
+#ifndef DS1307_LINUX_BATCH_STOPS
+#define DS1307_LINUX_BATCH_STOPS	8U
+#endif
+
+/**
+ * @brief  I2C bus handle.
+ */
+typedef struct {
+	int fd; /*!< File descriptor of the i2c-dev device (-1 when closed) */
+} ds1307_linux_bus_t;
+
+/**
+ * @brief  Batch of I2C messages, sent in one ioctl per raw write plus one for the rest.
+ */
+typedef struct {
+	ds1307_linux_bus_t *bus; /*!< Bus the batch is sent on */
+	struct i2c_msg *msgs; /*!< User-provided message table */
+	uint8_t capacity; /*!< Number of entries in the message table */
+	uint8_t count; /*!< Number of queued messages */
+	uint8_t *buffer; /*!< User-provided buffer for register addresses and write data */
+	uint16_t buffer_size; /*!< Size of the buffer in bytes */
+	uint16_t used; /*!< Bytes of the buffer in use */
+	uint8_t stops[DS1307_LINUX_BATCH_STOPS]; /*!< Message counts at which an ioctl ends (after each raw write) */
+	uint8_t stop_count; /*!< Number of queued raw writes */
+} ds1307_linux_batch_t;
+
+/**
+ * @brief  Opens an i2c-dev device (e.g. "/dev/i2c-1").
+ */
+ds1307_status_t ds1307_linux_open(ds1307_linux_bus_t *bus, const char *path);
+
+/**
+ * @brief  Closes the i2c-dev device.
+ */
+void ds1307_linux_close(ds1307_linux_bus_t *bus);
+
+/**
+ * @brief  Sets the transport functions and the handle of a driver configuration to the bus.
+ */
+void ds1307_linux_bind(ds1307_user_func_t *functions, ds1307_linux_bus_t *bus);
+
+/**
+ * @brief  Transport write function (@ref ds1307_i2c_mem_write_func_t); the handle is a ds1307_linux_bus_t.
+ */
+ds1307_status_t ds1307_linux_write(void *handle, ds1307_adr_t address,
+		ds1307_reg_adr_t reg_adr, uint8_t *data, uint16_t size);
+
+/**
+ * @brief  Transport read function (@ref ds1307_i2c_mem_read_func_t); the handle is a ds1307_linux_bus_t.
+ */
+ds1307_status_t ds1307_linux_read(void *handle, ds1307_adr_t address,
+		ds1307_reg_adr_t reg_adr, uint8_t *data, uint16_t size);
+
+/**
+ * @brief  Initializes a batch with a user-provided message table and buffer.
+ */
+void ds1307_linux_batch_init(ds1307_linux_batch_t *batch,
+		ds1307_linux_bus_t *bus, struct i2c_msg *msgs, uint8_t capacity,
+		uint8_t *buffer, uint16_t buffer_size);
+
+/**
+ * @brief  Queues a register write; returns 0 if the batch is full.
+ */
+uint8_t ds1307_linux_batch_write(ds1307_linux_batch_t *batch,
+		uint8_t address, ds1307_reg_adr_t reg_adr, const uint8_t *data,
+		uint16_t size);
+
+/**
+ * @brief  Queues a write of raw bytes without a register address (e.g. a multiplexer select) that ends its ioctl; returns 0 if the batch is full.
+ */
+uint8_t ds1307_linux_batch_raw(ds1307_linux_batch_t *batch, uint8_t address,
+		const uint8_t *data, uint16_t size);
+
+/**
+ * @brief  Queues a register read; returns 0 if the batch is full.
+ */
+uint8_t ds1307_linux_batch_read(ds1307_linux_batch_t *batch, uint8_t address,
+		ds1307_reg_adr_t reg_adr, uint8_t *data, uint16_t size);
+
+/**
+ * @brief  Sends all queued messages, split into one ioctl after each raw write, and empties the batch.
+ */
+ds1307_status_t ds1307_linux_batch_run(ds1307_linux_batch_t *batch);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_DS1307_LINUX_H_ */
@@ -0,0 +1,165 @@
+/**
+  ******************************************************************************
+  * @file    DS1307_mux.c
+  * @author  iek2443
+  * @brief   Source file for the DS1307 multi-device manager.
+  *          Keeps a channel-ordered device table and reads all devices in a
+  *          single sweep with the minimum number of multiplexer switches.
+  ******************************************************************************
+  * @attention
+  *
+  * All devices sit behind one multiplexer on one bus, so they share a single
+  * regular DS1307 context for the transfers. Each table entry keeps the raw
+  * register image of its device as a ds1307_compact_t, decoded on access. A
+  * channel select and the device access behind it run under the bus lock of
+  * the shared context.
+  *
+  ******************************************************************************
+  */
+#include "DS1307_mux.h"
+
+#include <string.h>
+
+static ds1307_status_t ds1307_mux_select(ds1307_mux_t *mux, uint8_t channel);
+
+/**
+  * @brief  Initializes the multi-device manager.
+  * @param  mux: Pointer to the manager structure to initialize.
+  * @param  devices: User-provided device table.
+  * @param  capacity: Number of entries in the device table.
+  * @param  rtc: Pointer to the configured DS1307 context used for every device.
+  * @param  select: User-defined multiplexer channel select function.
+  * @param  mux_handle: User-defined multiplexer handle passed to the select function.
+  * @retval None
+  */
+void ds1307_mux_init(ds1307_mux_t *mux, ds1307_mux_device_t *devices,
+		uint8_t capacity, ds1307_context_t *rtc,
+		ds1307_mux_select_func_t select, void *mux_handle) {
+	mux->rtc = rtc;
+	mux->devices = devices;
+	mux->capacity = capacity;
+	mux->count = 0;
+	mux->select = select;
+	mux->mux_handle = mux_handle;
+	mux->channel = 0;
+	mux->channel_valid = 0;
+}
+
+/**
+  * @brief  Registers a device on a multiplexer channel.
+  * @param  mux: Pointer to the manager structure.
+  * @param  channel: Multiplexer channel the device is connected to.
+  * @retval Non-zero on success, zero when the device table is full or the channel is already registered.
+  * @note   The table is kept sorted by channel, so a sweep never returns to a channel it has
+  *         already left. Registering a device shifts the indexes of devices on higher channels;
+  *         a device is identified by its channel (see @ref ds1307_mux_time). The time of the
+  *         entry is zero until the first @ref ds1307_mux_read_all.
+  */
+uint8_t ds1307_mux_add(ds1307_mux_t *mux, uint8_t channel) {
+	uint8_t i;
+
+	if (mux->count >= mux->capacity || ds1307_mux_time(mux, channel)) {
+		return 0;
+	}
+	i = mux->count;
+	while (i > 0 && mux->devices[i - 1U].channel > channel) {
+		mux->devices[i] = mux->devices[i - 1U];
+		i--;
+	}
+	memset(&mux->devices[i].time, 0, sizeof(mux->devices[i].time));
+	mux->devices[i].channel = channel;
+	mux->count++;
+	return 1;
+}
+
+/**
+  * @brief  Returns the time of the device on a channel as read by the last sweep.
+  * @param  mux: Pointer to the manager structure.
+  * @param  channel: Multiplexer channel of the device.
+  * @retval Pointer to the compact timestamp of the device, or NULL if no device is registered on the channel.
+  * @note   Decode the fields with the ds1307_compact_* accessors or format it with
+  *         ds1307_compact_format_iso8601. No I2C transfer is made.
+  */
+const ds1307_compact_t* ds1307_mux_time(const ds1307_mux_t *mux,
+		uint8_t channel) {
+	uint8_t i;
+
+	for (i = 0; i < mux->count; i++) {
+		if (mux->devices[i].channel == channel) {
+			return &mux->devices[i].time;
+		}
+	}
+	return 0;
+}
+
+/**
+  * @brief  Selects the multiplexer channel of a registered device.
+  * @param  mux: Pointer to the manager structure.
+  * @param  index: Index of the device in the table.
+  * @retval Pointer to the shared context, now addressing the device, ready for use with the regular driver
+  *         API, or NULL if the index is invalid or the channel could not be selected.
+  * @note   On success the bus lock of the shared context is held, so no other task can switch the
+  *         multiplexer before the device has been accessed. Release it with @ref ds1307_unlock once
+  *         the transfers on the device are done. On failure no lock is held. The date and time
+  *         fields of the shared context belong to whichever device was accessed last.
+  */
+ds1307_context_t* ds1307_mux_select_device(ds1307_mux_t *mux, uint8_t index) {
+	if (index >= mux->count) {
+		return 0;
+	}
+	ds1307_lock(mux->rtc);
+	if (ds1307_mux_select(mux, mux->devices[index].channel) != DS1307_OK) {
+		ds1307_unlock(mux->rtc);
+		return 0;
+	}
+	return mux->rtc;
+}
+
+/**
+  * @brief  Reads the full date and time of every registered device.
+  * @param  mux: Pointer to the manager structure.
+  * @retval @ref DS1307_OK if every device was read, otherwise the first error encountered.
+  * @note   Devices are visited in channel order. Each device costs one burst read into the compact
+  *         timestamp of its entry, and the multiplexer is switched at most once per distinct channel.
+  *         A failing device does not stop the sweep and keeps its previous time; devices behind a
+  *         channel that cannot be selected are skipped. The bus lock of the shared context is held
+  *         from each channel select to the end of the read behind it, so another task cannot switch
+  *         the multiplexer in between.
+  */
+ds1307_status_t ds1307_mux_read_all(ds1307_mux_t *mux) {
+	ds1307_status_t result = DS1307_OK;
+	ds1307_status_t status;
+	uint8_t i;
+
+	for (i = 0; i < mux->count; i++) {
+		ds1307_lock(mux->rtc);
+		status = ds1307_mux_select(mux, mux->devices[i].channel);
+		if (status == DS1307_OK) {
+			status = ds1307_compact_read(mux->rtc, &mux->devices[i].time);
+		}
+		ds1307_unlock(mux->rtc);
+		if (result == DS1307_OK) {
+			result = status;
+		}
+	}
+	return result;
+}
+
+/**
+  * @brief  Switches the multiplexer to a channel unless it is already selected.
+  * @param  mux: Pointer to the manager structure.
+  * @param  channel: Channel to select.
+  * @retval Status of the select function (@ref DS1307_OK if the channel was already selected).
+  * @note   The cached channel is invalidated when the select fails, so the next call switches again.
+  */
+static ds1307_status_t ds1307_mux_select(ds1307_mux_t *mux, uint8_t channel) {
+	ds1307_status_t status;
+
+	if (mux->channel_valid && mux->channel == channel) {
+		return DS1307_OK;
+	}
+	status = mux->select(mux->mux_handle, channel);
+	mux->channel = channel;
+	mux->channel_valid = (status == DS1307_OK);
+	return status;
+}
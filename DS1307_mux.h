@@ -0,0 +1,93 @@
+/**
+  ******************************************************************************
+  * @file    DS1307_mux.h
+  * @author  iek2443
+  * @brief   Header file for the DS1307 multi-device manager.
+  *          Contains the device table structures and function prototypes for
+  *          operating many DS1307 devices behind I2C multiplexers.
+  ******************************************************************************
+  * @attention
+  *
+  * All DS1307 devices share the fixed I2C address 0x68, so several devices on
+  * one bus must sit on different channels of a TCA9548-style multiplexer.
+  * The manager keeps the device table ordered by channel and only switches the
+  * multiplexer when the next device is on a different channel. All devices are
+  * accessed through one shared context; the table only holds the channel and
+  * the last read time of each device as a compact timestamp, 9 bytes per
+  * device instead of a full ds1307_context_t.
+  *
+  ******************************************************************************
+  */
+
+#ifndef INC_DS1307_MUX_H_
+#define INC_DS1307_MUX_H_
+
+#include "DS1307.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief  Function pointer type for selecting a multiplexer channel.
+ * @param  mux_handle: User-defined multiplexer handle.
+ * @param  channel: Channel to select.
+ * @retval @ref DS1307_OK on success, otherwise the error to report.
+ */
+typedef ds1307_status_t (*ds1307_mux_select_func_t)(void *mux_handle, uint8_t channel);
+
+/**
+ * @brief  Entry of the device table.
+ */
+typedef struct {
+	ds1307_compact_t time; /*!< Date and time of the device at the last @ref ds1307_mux_read_all */
+	uint8_t channel; /*!< Multiplexer channel the device is connected to */
+} ds1307_mux_device_t;
+
+/**
+ * @brief  DS1307 multi-device manager structure.
+ */
+typedef struct {
+	ds1307_context_t *rtc; /*!< Configured DS1307 context shared by all devices for I2C access */
+	ds1307_mux_device_t *devices; /*!< User-provided device table, kept ordered by channel */
+	uint8_t capacity; /*!< Number of entries in the device table */
+	uint8_t count; /*!< Number of registered devices */
+	ds1307_mux_select_func_t select; /*!< User-defined channel select function */
+	void *mux_handle; /*!< User-defined multiplexer handle passed to the select function */
+	uint8_t channel; /*!< Currently selected channel */
+	uint8_t channel_valid; /*!< Non-zero once a channel has been selected */
+} ds1307_mux_t;
+
+/**
+ * @brief  Initializes the manager with a user-provided device table.
+ */
+void ds1307_mux_init(ds1307_mux_t *mux, ds1307_mux_device_t *devices,
+		uint8_t capacity, ds1307_context_t *rtc,
+		ds1307_mux_select_func_t select, void *mux_handle);
+
+/**
+ * @brief  Registers a device on a multiplexer channel.
+ */
+uint8_t ds1307_mux_add(ds1307_mux_t *mux, uint8_t channel);
+
+/**
+ * @brief  Returns the last read time of the device on a channel, or NULL if there is none.
+ */
+const ds1307_compact_t* ds1307_mux_time(const ds1307_mux_t *mux,
+		uint8_t channel);
+
+/**
+ * @brief  Selects the channel of a registered device and returns the shared context; holds the bus lock on success.
+ */
+ds1307_context_t* ds1307_mux_select_device(ds1307_mux_t *mux, uint8_t index);
+
+/**
+ * @brief  Reads the date and time of every registered device in one sweep ordered by channel.
+ */
+ds1307_status_t ds1307_mux_read_all(ds1307_mux_t *mux);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_DS1307_MUX_H_ */
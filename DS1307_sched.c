@@ -0,0 +1,167 @@
+/**
+  ******************************************************************************
+  * @file    DS1307_sched.c
+  * @author  iek2443
+  * @brief   Source file for the DS1307 refresh scheduler.
+  *          Reads the device at one rate or on the SQW/OUT edge and fans the
+  *          result out to the registered subscribers.
+  ******************************************************************************
+  * @attention
+  *
+  * Subscribers read the new date and time from the scheduler context inside
+  * their notification; they must not start bus transfers of their own on it.
+  *
+  ******************************************************************************
+  */
+#include "DS1307_sched.h"
+
+static uint8_t ds1307_sched_diff(const uint8_t *prev, const uint8_t *regs);
+
+/**
+  * @brief  Initializes the refresh scheduler.
+  * @param  sched: Pointer to the scheduler structure to initialize.
+  * @param  rtc: Pointer to a configured DS1307 context structure, owned by the scheduler from now on.
+  * @param  subscribers: User-provided subscriber table.
+  * @param  capacity: Number of entries in the subscriber table.
+  * @param  tick_ms: User-defined monotonic millisecond tick function (may be NULL if period_ms is 0).
+  * @param  period_ms: Refresh period of @ref ds1307_sched_poll (0 = only on the SQW/OUT edge).
+  * @retval None
+  * @note   The first refresh reports all events, so subscribers receive the initial time.
+  */
+void ds1307_sched_init(ds1307_sched_t *sched, ds1307_context_t *rtc,
+		ds1307_sched_subscriber_t *subscribers, uint8_t capacity,
+		ds1307_tick_func_t tick_ms, uint32_t period_ms) {
+	sched->rtc = rtc;
+	sched->subscribers = subscribers;
+	sched->capacity = capacity;
+	sched->count = 0;
+	sched->tick_ms = tick_ms;
+	sched->period_ms = period_ms;
+	sched->last_tick = tick_ms ? tick_ms() : 0U;
+	sched->prev_valid = 0;
+	sched->sqw_pending = 1;
+}
+
+/**
+  * @brief  Registers a subscriber.
+  * @param  sched: Pointer to the scheduler structure.
+  * @param  events: DS1307_EVENT_* bits the subscriber is notified of.
+  * @param  notify: Notification function.
+  * @param  user: User data passed to the notification function (may be NULL).
+  * @retval Non-zero on success, zero when the subscriber table is full.
+  * @note   Subscribers are notified in registration order.
+  */
+uint8_t ds1307_sched_subscribe(ds1307_sched_t *sched, uint8_t events,
+		ds1307_sched_notify_func_t notify, void *user) {
+	ds1307_sched_subscriber_t *subscriber;
+
+	if (sched->count >= sched->capacity) {
+		return 0;
+	}
+	subscriber = &sched->subscribers[sched->count];
+	subscriber->notify = notify;
+	subscriber->user = user;
+	subscriber->events = events;
+	sched->count++;
+	return 1;
+}
+
+/**
+  * @brief  Requests a refresh from the SQW/OUT edge.
+  * @param  sched: Pointer to the scheduler structure.
+  * @retval None
+  * @note   Safe to call from the edge interrupt; the read itself is made by the next
+  *         @ref ds1307_sched_poll. Configure the pin with @ref ds1307_set_sqw (1 Hz).
+  */
+void ds1307_sched_sqw_edge(ds1307_sched_t *sched) {
+	sched->sqw_pending = 1;
+}
+
+/**
+  * @brief  Refreshes the scheduler when it is due.
+  * @param  sched: Pointer to the scheduler structure.
+  * @retval Status of the refresh, @ref DS1307_OK if none was due.
+  * @note   A refresh is due when an SQW edge is pending or, with a non-zero period, when the
+  *         period has elapsed since the last refresh.
+  */
+ds1307_status_t ds1307_sched_poll(ds1307_sched_t *sched) {
+	if (sched->sqw_pending) {
+		return ds1307_sched_refresh(sched);
+	}
+	if (sched->period_ms != 0
+			&& (uint32_t) (sched->tick_ms() - sched->last_tick)
+					>= sched->period_ms) {
+		return ds1307_sched_refresh(sched);
+	}
+	return DS1307_OK;
+}
+
+/**
+  * @brief  Reads the device and notifies the subscribers of the changed fields.
+  * @param  sched: Pointer to the scheduler structure.
+  * @retval Status of the read. Subscribers are not notified if it fails.
+  * @note   One burst read per call, whatever the number of subscribers. Subscribers whose
+  *         events did not occur are skipped.
+  */
+ds1307_status_t ds1307_sched_refresh(ds1307_sched_t *sched) {
+	ds1307_context_t *rtc = sched->rtc;
+	ds1307_sched_subscriber_t *subscriber;
+	ds1307_status_t status;
+	uint8_t events;
+	uint8_t i;
+
+	sched->sqw_pending = 0;
+	if (sched->tick_ms) {
+		sched->last_tick = sched->tick_ms();
+	}
+	status = DS1307_read_date_time(rtc);
+	if (status != DS1307_OK) {
+		return status;
+	}
+
+	events = sched->prev_valid ?
+			ds1307_sched_diff(sched->prev, rtc->regs) : DS1307_EVENT_ALL;
+	for (i = 0; i < DS1307_TIME_REG_COUNT; i++) {
+		sched->prev[i] = rtc->regs[i];
+	}
+	sched->prev_valid = 1;
+
+	if (events == 0) {
+		return DS1307_OK;
+	}
+	for (i = 0; i < sched->count; i++) {
+		subscriber = &sched->subscribers[i];
+		if (subscriber->events & events) {
+			subscriber->notify(rtc, subscriber->events & events,
+					subscriber->user);
+		}
+	}
+	return DS1307_OK;
+}
+
+/**
+  * @brief  Works out the change events between two raw register images.
+  * @param  prev: Raw register image of the previous refresh.
+  * @param  regs: Raw register image of the current refresh.
+  * @retval DS1307_EVENT_* bits; a coarser change includes all finer events.
+  * @note   The CH bit and the hour format bits are part of the compared bytes, so a clock
+  *         start/stop or a format switch is reported as a change of that field.
+  */
+static uint8_t ds1307_sched_diff(const uint8_t *prev, const uint8_t *regs) {
+	if (prev[DS1307_DAY_REG_ADR] != regs[DS1307_DAY_REG_ADR]
+			|| prev[DS1307_DATE_REG_ADR] != regs[DS1307_DATE_REG_ADR]
+			|| prev[DS1307_MONTH_REG_ADR] != regs[DS1307_MONTH_REG_ADR]
+			|| prev[DS1307_YEAR_REG_ADR] != regs[DS1307_YEAR_REG_ADR]) {
+		return DS1307_EVENT_ALL;
+	}
+	if (prev[DS1307_HOUR_REG_ADR] != regs[DS1307_HOUR_REG_ADR]) {
+		return DS1307_EVENT_HOUR | DS1307_EVENT_MINUTE | DS1307_EVENT_SECOND;
+	}
+	if (prev[DS1307_MIN_REG_ADR] != regs[DS1307_MIN_REG_ADR]) {
+		return DS1307_EVENT_MINUTE | DS1307_EVENT_SECOND;
+	}
+	if (prev[DS1307_SEC_REG_ADR] != regs[DS1307_SEC_REG_ADR]) {
+		return DS1307_EVENT_SECOND;
+	}
+	return 0;
+}
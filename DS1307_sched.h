@@ -0,0 +1,107 @@
+/**
+  ******************************************************************************
+  * @file    DS1307_sched.h
+  * @author  iek2443
+  * @brief   Header file for the DS1307 refresh scheduler.
+  *          Contains the scheduler and subscriber structures and function
+  *          prototypes for sharing one periodic device read between modules.
+  ******************************************************************************
+  * @attention
+  *
+  * The scheduler owns the context: it reads the device at one rate, or on
+  * the SQW/OUT edge, works out which fields changed by comparing the raw
+  * register image with the previous read and notifies the subscribers of
+  * those changes. Any number of consumers cost one bus read per refresh.
+  *
+  ******************************************************************************
+  */
+
+#ifndef INC_DS1307_SCHED_H_
+#define INC_DS1307_SCHED_H_
+
+#include "DS1307.h"
+#include "DS1307_cache.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief  Change events reported to subscribers (bit mask).
+ * @note   A change of a coarser field always includes the finer events, e.g. a new minute is
+ *         reported as DS1307_EVENT_MINUTE | DS1307_EVENT_SECOND.
+ */
+#define DS1307_EVENT_SECOND		(1U << 0) /*!< Seconds register changed */
+#define DS1307_EVENT_MINUTE		(1U << 1) /*!< Minutes register changed */
+#define DS1307_EVENT_HOUR		(1U << 2) /*!< Hours register changed */
+#define DS1307_EVENT_DAY		(1U << 3) /*!< Day, date, month or year register changed */
+#define DS1307_EVENT_ALL		(DS1307_EVENT_SECOND | DS1307_EVENT_MINUTE | DS1307_EVENT_HOUR | DS1307_EVENT_DAY)
+
+/**
+ * @brief  Function pointer type for the subscriber notification.
+ * @param  rtc: Pointer to the scheduler context holding the new date and time.
+ * @param  events: DS1307_EVENT_* bits that occurred, limited to the ones the subscriber asked for.
+ * @param  user: User data given at subscription.
+ * @retval None
+ */
+typedef void (*ds1307_sched_notify_func_t)(const ds1307_context_t *rtc,
+		uint8_t events, void *user);
+
+/**
+ * @brief  Entry of the subscriber table.
+ */
+typedef struct {
+	ds1307_sched_notify_func_t notify; /*!< Notification function */
+	void *user; /*!< User data passed to the notification function */
+	uint8_t events; /*!< DS1307_EVENT_* bits the subscriber is interested in */
+} ds1307_sched_subscriber_t;
+
+/**
+ * @brief  DS1307 refresh scheduler structure.
+ */
+typedef struct {
+	ds1307_context_t *rtc; /*!< Context owned by the scheduler, holds the last read date and time */
+	ds1307_sched_subscriber_t *subscribers; /*!< User-provided subscriber table */
+	uint8_t capacity; /*!< Number of entries in the subscriber table */
+	uint8_t count; /*!< Number of registered subscribers */
+	ds1307_tick_func_t tick_ms; /*!< User-defined millisecond tick function (may be NULL without periodic refresh) */
+	uint32_t period_ms; /*!< Refresh period (0 = only on the SQW/OUT edge) */
+	uint32_t last_tick; /*!< Tick value at the last refresh */
+	uint8_t prev[DS1307_TIME_REG_COUNT]; /*!< Raw register image of the previous refresh */
+	uint8_t prev_valid; /*!< Non-zero once a refresh has succeeded */
+	volatile uint8_t sqw_pending; /*!< Set by @ref ds1307_sched_sqw_edge, cleared by the next refresh */
+} ds1307_sched_t;
+
+/**
+ * @brief  Initializes the scheduler with a user-provided subscriber table.
+ */
+void ds1307_sched_init(ds1307_sched_t *sched, ds1307_context_t *rtc,
+		ds1307_sched_subscriber_t *subscribers, uint8_t capacity,
+		ds1307_tick_func_t tick_ms, uint32_t period_ms);
+
+/**
+ * @brief  Registers a subscriber for a set of change events.
+ */
+uint8_t ds1307_sched_subscribe(ds1307_sched_t *sched, uint8_t events,
+		ds1307_sched_notify_func_t notify, void *user);
+
+/**
+ * @brief  Requests a refresh from the SQW/OUT edge interrupt (no I2C access).
+ */
+void ds1307_sched_sqw_edge(ds1307_sched_t *sched);
+
+/**
+ * @brief  Refreshes when the period has elapsed or an SQW edge is pending; call from the main loop or a task.
+ */
+ds1307_status_t ds1307_sched_poll(ds1307_sched_t *sched);
+
+/**
+ * @brief  Reads the device now and notifies the subscribers of the changed fields.
+ */
+ds1307_status_t ds1307_sched_refresh(ds1307_sched_t *sched);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_DS1307_SCHED_H_ */
@@ -0,0 +1,176 @@
+/**
+  ******************************************************************************
+  * @file    DS1307_tz.c
+  * @author  iek2443
+  * @brief   Source file for the DS1307 time zone layer.
+  *          Converts UTC timestamps to local time and computes the daylight
+  *          saving transitions of a zone from its rules.
+  ******************************************************************************
+  * @attention
+  *
+  * The cached interval is checked with a single unsigned compare,
+  * (utc - since) < span, which also catches a time set backwards. The rule
+  * evaluation only runs on a transition, after a clock change, and on the
+  * first conversion.
+  *
+  ******************************************************************************
+  */
+#include "DS1307_tz.h"
+
+static int64_t ds1307_tz_transition(const ds1307_tz_rule_t *rule,
+		int32_t year, int32_t offset);
+static int32_t ds1307_tz_days_from_civil(int32_t year, uint32_t month,
+		uint32_t day);
+static int32_t ds1307_tz_year(uint32_t epoch);
+
+/**
+  * @brief  Initializes a converter for a time zone.
+  * @param  tz: Pointer to the converter structure.
+  * @param  zone: Pointer to the time zone definition (kept by reference).
+  * @retval None
+  * @note   The rules are evaluated on the first conversion.
+  */
+void ds1307_tz_init(ds1307_tz_t *tz, const ds1307_tz_zone_t *zone) {
+	tz->zone = zone;
+	tz->since = 0;
+	tz->span = 0;
+	tz->offset = zone->std_offset;
+	tz->dst = 0;
+}
+
+/**
+  * @brief  Converts a UTC Unix timestamp to local time.
+  * @param  tz: Pointer to the converter structure.
+  * @param  utc: UTC Unix timestamp, e.g. ds1307_to_epoch(&ds1307).
+  * @retval Local time as a Unix-style timestamp, for @ref ds1307_from_epoch or display.
+  */
+uint32_t ds1307_tz_local(ds1307_tz_t *tz, uint32_t utc) {
+	if ((uint32_t) (utc - tz->since) >= tz->span) {
+		ds1307_tz_update(tz, utc);
+	}
+	return utc + (uint32_t) tz->offset;
+}
+
+/**
+  * @brief  Evaluates the rules for a UTC time and caches the offset until the next transition.
+  * @param  tz: Pointer to the converter structure.
+  * @param  utc: UTC Unix timestamp.
+  * @retval None
+  * @note   The transitions of the year of utc and of the years before and after it are computed,
+  *         so zones of both hemispheres (daylight saving across the new year) are handled.
+  *         A zone without daylight saving gets one interval covering all timestamps.
+  */
+void ds1307_tz_update(ds1307_tz_t *tz, uint32_t utc) {
+	const ds1307_tz_zone_t *zone = tz->zone;
+	int64_t prev = -1;
+	int64_t next = 0x100000000LL;
+	int64_t t;
+	int32_t year;
+	uint8_t dst = 0;
+	uint8_t i;
+
+	if (zone->dst_start.month == 0) {
+		tz->since = 0;
+		tz->span = 0xFFFFFFFFUL;
+		tz->offset = zone->std_offset;
+		tz->dst = 0;
+		return;
+	}
+
+	year = ds1307_tz_year(utc);
+	for (i = 0; i < 6U; i++) {
+		if (i & 1U) {
+			t = ds1307_tz_transition(&zone->dst_end, year - 1 + (i >> 1),
+					zone->dst_offset);
+		} else {
+			t = ds1307_tz_transition(&zone->dst_start, year - 1 + (i >> 1),
+					zone->std_offset);
+		}
+		if (t <= (int64_t) utc) {
+			if (t > prev) {
+				prev = t;
+				dst = !(i & 1U);
+			}
+		} else if (t < next) {
+			next = t;
+		}
+	}
+	if (prev < 0) {
+		prev = 0;
+	}
+	if (next > 0xFFFFFFFFLL) {
+		next = 0xFFFFFFFFLL;
+	}
+	tz->since = (uint32_t) prev;
+	tz->span = (uint32_t) (next - prev);
+	tz->dst = dst;
+	tz->offset = dst ? zone->dst_offset : zone->std_offset;
+}
+
+/**
+  * @brief  Returns the UTC time of the next transition.
+  * @param  tz: Pointer to the converter structure.
+  * @retval End of the cached interval, 0xFFFFFFFF for a zone without daylight saving.
+  */
+uint32_t ds1307_tz_next(const ds1307_tz_t *tz) {
+	return tz->since + tz->span;
+}
+
+/**
+  * @brief  Computes the UTC time of a transition in a given year.
+  * @param  rule: Transition rule.
+  * @param  year: Year.
+  * @param  offset: Offset in effect before the transition.
+  * @retval UTC Unix timestamp of the transition.
+  */
+static int64_t ds1307_tz_transition(const ds1307_tz_rule_t *rule,
+		int32_t year, int32_t offset) {
+	int32_t first = ds1307_tz_days_from_civil(year, rule->month, 1);
+	int32_t length = ds1307_tz_days_from_civil(
+			rule->month == 12U ? year + 1 : year,
+			rule->month == 12U ? 1U : rule->month + 1U, 1) - first;
+	/* 1970-01-01 was a Thursday */
+	int32_t weekday = (first + 3) % 7 + 1;
+	int32_t day = ((int32_t) rule->weekday - weekday + 7) % 7
+			+ 7 * (rule->week - 1);
+
+	while (day >= length) {
+		day -= 7;
+	}
+	return (int64_t) (first + day) * 86400LL + rule->time - offset;
+}
+
+/**
+  * @brief  Returns the number of days since 1970-01-01 of a civil date.
+  * @param  year: Year.
+  * @param  month: Month (1–12).
+  * @param  day: Day of the month (1–31).
+  * @retval Days since 1970-01-01.
+  */
+static int32_t ds1307_tz_days_from_civil(int32_t year, uint32_t month,
+		uint32_t day) {
+	uint32_t yoe;
+	uint32_t doy;
+
+	year -= (month <= 2U);
+	yoe = (uint32_t) (year % 400);
+	doy = (153U * (month > 2U ? month - 3U : month + 9U) + 2U) / 5U + day - 1U;
+	return (year / 400) * 146097
+			+ (int32_t) (yoe * 365U + yoe / 4U - yoe / 100U + doy) - 719468;
+}
+
+/**
+  * @brief  Returns the year of a Unix timestamp.
+  * @param  epoch: Unix timestamp.
+  * @retval Year.
+  */
+static int32_t ds1307_tz_year(uint32_t epoch) {
+	uint32_t z = epoch / 86400U + 719468U; /* days since 0000-03-01 */
+	uint32_t era = z / 146097U;
+	uint32_t doe = z - era * 146097U;
+	uint32_t yoe = (doe - doe / 1460U + doe / 36524U - doe / 146096U) / 365U;
+	uint32_t doy = doe - (365U * yoe + yoe / 4U - yoe / 100U);
+	uint32_t mp = (5U * doy + 2U) / 153U;
+
+	return (int32_t) (yoe + era * 400U + (mp >= 10U));
+}
@@ -0,0 +1,84 @@
+/**
+  ******************************************************************************
+  * @file    DS1307_tz.h
+  * @author  iek2443
+  * @brief   Header file for the DS1307 time zone layer.
+  *          Contains the zone, rule and converter structures and function
+  *          prototypes for UTC to local time conversion with daylight saving.
+  ******************************************************************************
+  * @attention
+  *
+  * The device keeps UTC. The converter caches the offset in effect together
+  * with the UTC interval it is valid for (from the previous to the next
+  * transition), so a conversion is one compare and one add; the rules are
+  * only evaluated again when a transition is crossed.
+  *
+  ******************************************************************************
+  */
+
+#ifndef INC_DS1307_TZ_H_
+#define INC_DS1307_TZ_H_
+
+#include "DS1307.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief  Daylight saving transition rule: the n-th weekday of a month at a local time.
+ * @note   As in POSIX TZ rules, the time is the local time in effect before the transition.
+ */
+typedef struct {
+	uint8_t month; /*!< Month (1–12), 0 for a zone without daylight saving */
+	uint8_t week; /*!< Week of the month (1–4), 5 for the last one */
+	ds1307_day_t weekday; /*!< Day of the week */
+	uint32_t time; /*!< Seconds after local midnight */
+} ds1307_tz_rule_t;
+
+/**
+ * @brief  Time zone definition.
+ */
+typedef struct {
+	int32_t std_offset; /*!< Standard time offset from UTC in seconds (east positive) */
+	int32_t dst_offset; /*!< Daylight saving time offset from UTC in seconds */
+	ds1307_tz_rule_t dst_start; /*!< Start of daylight saving time */
+	ds1307_tz_rule_t dst_end; /*!< End of daylight saving time */
+} ds1307_tz_zone_t;
+
+/**
+ * @brief  UTC to local time converter.
+ */
+typedef struct {
+	const ds1307_tz_zone_t *zone; /*!< Time zone definition */
+	uint32_t since; /*!< UTC time of the previous transition */
+	uint32_t span; /*!< Seconds from the previous to the next transition */
+	int32_t offset; /*!< Offset in effect between the two transitions */
+	uint8_t dst; /*!< Non-zero if daylight saving time is in effect */
+} ds1307_tz_t;
+
+/**
+ * @brief  Initializes a converter for a time zone.
+ */
+void ds1307_tz_init(ds1307_tz_t *tz, const ds1307_tz_zone_t *zone);
+
+/**
+ * @brief  Converts a UTC Unix timestamp to local time.
+ */
+uint32_t ds1307_tz_local(ds1307_tz_t *tz, uint32_t utc);
+
+/**
+ * @brief  Evaluates the rules for a UTC time and caches the offset until the next transition.
+ */
+void ds1307_tz_update(ds1307_tz_t *tz, uint32_t utc);
+
+/**
+ * @brief  Returns the UTC time of the next transition after the last converted time (0xFFFFFFFF if none).
+ */
+uint32_t ds1307_tz_next(const ds1307_tz_t *tz);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_DS1307_TZ_H_ */
@@ -0,0 +1,261 @@
+/**
+  ******************************************************************************
+  * @file    ds1307_bench.c
+  * @author  iek2443
+  * @brief   Host benchmark of the DS1307 driver bus usage.
+  *          Runs the driver calls against the simulated DS1307 and prints
+  *          transactions, bytes and modelled bus time per call.
+  ******************************************************************************
+  * @attention
+  *
+  * The output is a Markdown table; the Bus Cost section of README.md is
+  * generated with "make bench". Every case starts from the same device
+  * state: clock running at 2025-06-13 14:30:00 (Friday), 24-hour layout,
+  * context loaded with DS1307_read_date_time, counters cleared.
+  *
+  ******************************************************************************
+  */
+#include <stdio.h>
+#include <string.h>
+
+#include "DS1307.h"
+#include "DS1307_journal.h"
+#include "ds1307_sim.h"
+
+/**
+ * @brief  Benchmark case.
+ */
+typedef struct {
+	const char *name; /*!< Call(s) measured, as printed in the table */
+	void (*run)(ds1307_context_t *rtc, ds1307_sim_t *sim); /*!< Runs the call(s) */
+} bench_case_t;
+
+/*
+ * Benchmark cases. Each one runs the measured call(s) on the prepared context;
+ * cases that need more state set it up first and clear the counters before the call.
+ */
+static void bench_read_date_time(ds1307_context_t *rtc, ds1307_sim_t *sim) {
+	(void) sim;
+	DS1307_read_date_time(rtc);
+}
+
+static void bench_read_raw(ds1307_context_t *rtc, ds1307_sim_t *sim) {
+	(void) sim;
+	ds1307_read_raw(rtc);
+}
+
+static void bench_compact_read(ds1307_context_t *rtc, ds1307_sim_t *sim) {
+	ds1307_compact_t time;
+
+	(void) sim;
+	ds1307_compact_read(rtc, &time);
+}
+
+static void bench_init(ds1307_context_t *rtc, ds1307_sim_t *sim) {
+	ds1307_boot_t boot;
+
+	(void) sim;
+	ds1307_init(rtc, &boot);
+}
+
+static void bench_get_second(ds1307_context_t *rtc, ds1307_sim_t *sim) {
+	(void) sim;
+	ds1307_get_second(rtc);
+}
+
+static void bench_get_all(ds1307_context_t *rtc, ds1307_sim_t *sim) {
+	(void) sim;
+	ds1307_get_year(rtc);
+	ds1307_get_month(rtc);
+	ds1307_get_date(rtc);
+	ds1307_get_day(rtc);
+	ds1307_get_hour(rtc);
+	ds1307_get_minute(rtc);
+	ds1307_get_second(rtc);
+}
+
+static void bench_set_second(ds1307_context_t *rtc, ds1307_sim_t *sim) {
+	(void) sim;
+	ds1307_set_second(rtc, 15);
+}
+
+static void bench_set_all(ds1307_context_t *rtc, ds1307_sim_t *sim) {
+	(void) sim;
+	ds1307_set_year(rtc, 2025);
+	ds1307_set_month(rtc, DS1307_JUNE);
+	ds1307_set_date(rtc, 13);
+	ds1307_set_day(rtc, DS1307_FRIDAY);
+	ds1307_set_hour(rtc, 14);
+	ds1307_set_minute(rtc, 30);
+	ds1307_set_second(rtc, 0);
+}
+
+static void bench_commit(ds1307_context_t *rtc, ds1307_sim_t *sim) {
+	(void) sim;
+	ds1307_set_write_mode(rtc, DS1307_WRITE_DEFERRED);
+	ds1307_set_minute(rtc, 45);
+	ds1307_set_hour(rtc, 9);
+	ds1307_set_date(rtc, 20);
+	ds1307_commit(rtc);
+	ds1307_set_write_mode(rtc, DS1307_WRITE_IMMEDIATE);
+}
+
+static void bench_set_date_time(ds1307_context_t *rtc, ds1307_sim_t *sim) {
+	(void) sim;
+	ds1307_set_date_time(rtc);
+}
+
+static void bench_compact_write(ds1307_context_t *rtc, ds1307_sim_t *sim) {
+	ds1307_compact_t time;
+
+	(void) sim;
+	ds1307_compact_pack(rtc, &time);
+	ds1307_compact_write(rtc, &time);
+}
+
+static void bench_set_time_format(ds1307_context_t *rtc, ds1307_sim_t *sim) {
+	(void) sim;
+	ds1307_set_time_format(rtc, DS1307_HOUR_FORMAT_12);
+}
+
+static void bench_set_time_format_rollover(ds1307_context_t *rtc,
+		ds1307_sim_t *sim) {
+	sim->regs[DS1307_SEC_REG_ADR] = 0x59;
+	sim->regs[DS1307_MIN_REG_ADR] = 0x59;
+	sim->phase_ns = 999800000UL;
+	sim->run_clock = 1;
+	ds1307_set_time_format(rtc, DS1307_HOUR_FORMAT_12);
+}
+
+static void bench_set_ch(ds1307_context_t *rtc, ds1307_sim_t *sim) {
+	(void) sim;
+	ds1307_set_ch(rtc, DS1307_CLOCK_DISABLE);
+}
+
+static void bench_set_sqw(ds1307_context_t *rtc, ds1307_sim_t *sim) {
+	(void) sim;
+	ds1307_set_sqw(rtc, DS1307_SQW_1HZ);
+}
+
+static void bench_get_sqw(ds1307_context_t *rtc, ds1307_sim_t *sim) {
+	(void) sim;
+	ds1307_get_sqw(rtc);
+}
+
+static void bench_nvram_read(ds1307_context_t *rtc, ds1307_sim_t *sim) {
+	uint8_t ram[DS1307_RAM_SIZE];
+
+	(void) sim;
+	ds1307_nvram_read(rtc, 0, ram, sizeof(ram));
+}
+
+static void bench_nvram_read_32(ds1307_context_t *rtc, ds1307_sim_t *sim) {
+	uint8_t ram[DS1307_RAM_SIZE];
+
+	(void) sim;
+	rtc->functions.max_transfer_size = 32;
+	ds1307_nvram_read(rtc, 0, ram, sizeof(ram));
+}
+
+static void bench_journal_filling(ds1307_context_t *rtc, ds1307_sim_t *sim) {
+	ds1307_journal_t journal;
+
+	ds1307_journal_open(&journal, rtc, 22, 34, 0);
+	ds1307_sim_reset_counters(sim);
+	ds1307_journal_append(&journal, 1749825000UL, 1);
+}
+
+static void bench_journal_full(ds1307_context_t *rtc, ds1307_sim_t *sim) {
+	ds1307_journal_t journal;
+	uint8_t i;
+
+	ds1307_journal_open(&journal, rtc, 22, 34, 0);
+	for (i = 0; i < journal.capacity; i++) {
+		ds1307_journal_append(&journal, 1749825000UL + i, 1);
+	}
+	ds1307_sim_reset_counters(sim);
+	ds1307_journal_append(&journal, 1749826000UL, 2);
+}
+
+static void bench_tick(ds1307_context_t *rtc, ds1307_sim_t *sim) {
+	(void) sim;
+	ds1307_tick(rtc);
+	ds1307_add_seconds(rtc, 3600);
+}
+
+static const bench_case_t bench_cases[] = {
+	{ "`DS1307_read_date_time()`", bench_read_date_time },
+	{ "`ds1307_read_raw()`", bench_read_raw },
+	{ "`ds1307_compact_read()`", bench_compact_read },
+	{ "`ds1307_init()`", bench_init },
+	{ "`ds1307_get_second()` (any one `ds1307_get_*()`)", bench_get_second },
+	{ "All seven `ds1307_get_*()`", bench_get_all },
+	{ "`ds1307_set_second()` (any one `ds1307_set_*()`)", bench_set_second },
+	{ "All seven `ds1307_set_*()`", bench_set_all },
+	{ "Deferred minute, hour, date + `ds1307_commit()`", bench_commit },
+	{ "`ds1307_set_date_time()`", bench_set_date_time },
+	{ "`ds1307_compact_pack()` + `ds1307_compact_write()`", bench_compact_write },
+	{ "`ds1307_set_time_format()` 24H to 12H", bench_set_time_format },
+	{ "`ds1307_set_time_format()` at xx:59:59, hour rollover", bench_set_time_format_rollover },
+	{ "`ds1307_set_ch()`", bench_set_ch },
+	{ "`ds1307_set_sqw()`", bench_set_sqw },
+	{ "`ds1307_get_sqw()`", bench_get_sqw },
+	{ "`ds1307_nvram_read()` of 56 bytes", bench_nvram_read },
+	{ "`ds1307_nvram_read()` of 56 bytes, `max_transfer_size` 32", bench_nvram_read_32 },
+	{ "`ds1307_journal_append()` while filling", bench_journal_filling },
+	{ "`ds1307_journal_append()` when full", bench_journal_full },
+	{ "`ds1307_tick()` + `ds1307_add_seconds()`", bench_tick }
+};
+
+/**
+  * @brief  Puts the model and the context into the common start state of a case.
+  * @param  rtc: Pointer to the context.
+  * @param  sim: Pointer to the model.
+  * @retval None
+  */
+static void bench_setup(ds1307_context_t *rtc, ds1307_sim_t *sim) {
+	static const uint8_t start[DS1307_TIME_REG_COUNT] = { 0x00, 0x30, 0x14,
+			0x05, 0x13, 0x06, 0x25 };
+	uint8_t i;
+
+	ds1307_sim_init(sim);
+	for (i = 0; i < DS1307_TIME_REG_COUNT; i++) {
+		sim->regs[i] = start[i];
+	}
+	memset(rtc, 0, sizeof(*rtc));
+	ds1307_sim_bind(&rtc->functions, sim);
+#if DS1307_CONFIG_CENTURY
+	rtc->century = 2000;
+#endif
+	DS1307_read_date_time(rtc);
+	ds1307_sim_reset_counters(sim);
+}
+
+/**
+  * @brief  Runs every case and prints the results as a Markdown table.
+  * @retval 0
+  */
+int main(void) {
+	ds1307_context_t rtc;
+	ds1307_sim_t sim;
+	uint8_t i;
+
+	ds1307_sim_init(&sim);
+	printf("Model: %u SCL clocks per byte, %u per START/STOP condition; "
+			"memory reads use a repeated start.\n\n",
+			(unsigned) sim.timing.clocks_per_byte,
+			(unsigned) sim.timing.clocks_per_condition);
+	printf("| Call | Transactions | Data bytes | Bus bytes | µs @ 100 kHz | µs @ 400 kHz |\n");
+	printf("|---|---|---|---|---|---|\n");
+	for (i = 0; i < sizeof(bench_cases) / sizeof(bench_cases[0]); i++) {
+		bench_setup(&rtc, &sim);
+		bench_cases[i].run(&rtc, &sim);
+		printf("| %s | %lu | %lu | %lu | %lu | %lu |\n", bench_cases[i].name,
+				(unsigned long) sim.counters.transactions,
+				(unsigned long) sim.counters.data_bytes,
+				(unsigned long) sim.counters.bus_bytes,
+				(unsigned long) ds1307_sim_clocks_to_us(&sim, 100000UL),
+				(unsigned long) ds1307_sim_clocks_to_us(&sim, 400000UL));
+	}
+	return 0;
+}
@@ -0,0 +1,241 @@
+/**
+  ******************************************************************************
+  * @file    ds1307_hpp_test.cpp
+  * @author  iek2443
+  * @brief   Host tests of the header-only C++ wrapper.
+  *          Builds DS1307.hpp as C++14 and runs it against the simulated
+  *          DS1307 through a compile-time transport.
+  ******************************************************************************
+  * @attention
+  *
+  * The expected register values are written out here, and the epoch of a
+  * time point is cross-checked with the C driver reading the same model.
+  * "make test" builds this file with -Wall -Wextra -pedantic and runs it.
+  *
+  ******************************************************************************
+  */
+#include <cstdio>
+#include <cstring>
+
+#include "DS1307.hpp"
+#include "ds1307_sim.h"
+
+#define TEST_CHECK(cond)	test_check((cond) != 0, __LINE__, #cond)
+
+static unsigned long test_checks;
+static unsigned long test_failures;
+
+/**
+  * @brief  Records the result of one check and reports the first failures.
+  * @param  ok: Non-zero if the check passed.
+  * @param  line: Source line of the check.
+  * @param  text: Text of the checked expression.
+  * @retval Non-zero if the check passed.
+  */
+static int test_check(int ok, int line, const char *text) {
+	test_checks++;
+	if (!ok) {
+		test_failures++;
+		if (test_failures <= 20U) {
+			std::printf("ds1307_hpp_test.cpp:%d: check failed: %s\n", line, text);
+		}
+	}
+	return ok;
+}
+
+/**
+ * @brief  Compile-time transport forwarding to the simulated DS1307.
+ */
+struct test_transport {
+	ds1307_sim_t *sim; /*!< Model answering the transfers */
+
+	ds1307_status_t write(ds1307_adr_t address, ds1307_reg_adr_t reg_adr,
+			uint8_t *data, uint16_t size) {
+		return ds1307_sim_write(sim, address, reg_adr, data, size);
+	}
+
+	ds1307_status_t read(ds1307_adr_t address, ds1307_reg_adr_t reg_adr,
+			uint8_t *data, uint16_t size) {
+		return ds1307_sim_read(sim, address, reg_adr, data, size);
+	}
+};
+
+using test_rtc = ds1307::DS1307<test_transport>;
+
+/**
+  * @brief  Reference encoding of the hours register.
+  * @param  format: Hour format of the register layout.
+  * @param  hour: Hour in 24-hour notation (0–23).
+  * @retval Register value.
+  */
+static uint8_t test_hour_reg(ds_1307_hour_format_t format, uint8_t hour) {
+	const uint8_t h12 = static_cast<uint8_t>(hour % 12U ? hour % 12U : 12U);
+
+	if (format == DS1307_HOUR_FORMAT_24) {
+		return static_cast<uint8_t>(((hour / 10U) << 4) | (hour % 10U));
+	}
+	return static_cast<uint8_t>(0x40U | (hour >= 12U ? 0x20U : 0U)
+			| ((h12 / 10U) << 4) | (h12 % 10U));
+}
+
+/**
+  * @brief  Single-register setters and reads: one transfer of one byte each.
+  * @retval None
+  */
+static void test_registers(void) {
+	ds1307_sim_t sim;
+	test_rtc rtc(test_transport { &sim });
+	uint8_t value = 0;
+
+	ds1307_sim_init(&sim);
+	TEST_CHECK(rtc.set_second(5) == DS1307_OK);
+	TEST_CHECK(sim.regs[DS1307_SEC_REG_ADR] == 0x05U);
+	ds1307_sim_reset_counters(&sim);
+	TEST_CHECK(rtc.set_minute(30) == DS1307_OK);
+	TEST_CHECK(sim.regs[DS1307_MIN_REG_ADR] == 0x30U);
+	TEST_CHECK(sim.counters.transactions == 1U && sim.counters.data_bytes == 1U);
+	TEST_CHECK(rtc.set_hour(23) == DS1307_OK && sim.regs[DS1307_HOUR_REG_ADR] == 0x23U);
+	TEST_CHECK(rtc.set_day(DS1307_SUNDAY) == DS1307_OK
+			&& sim.regs[DS1307_DAY_REG_ADR] == 0x07U);
+	TEST_CHECK(rtc.set_date(31) == DS1307_OK && sim.regs[DS1307_DATE_REG_ADR] == 0x31U);
+	TEST_CHECK(rtc.set_month(DS1307_DECEMBER) == DS1307_OK
+			&& sim.regs[DS1307_MONTH_REG_ADR] == 0x12U);
+	TEST_CHECK(rtc.set_year(2099) == DS1307_OK && sim.regs[DS1307_YEAR_REG_ADR] == 0x99U);
+	TEST_CHECK(rtc.set_sqw(DS1307_SQW_1HZ) == DS1307_OK
+			&& sim.regs[DS1307_CONT_REG_ADR] == 0x10U);
+	ds1307_sim_reset_counters(&sim);
+	TEST_CHECK(rtc.read_register<DS1307_MIN_REG_ADR>(value) == DS1307_OK && value == 0x30U);
+	TEST_CHECK(sim.counters.transactions == 1U && sim.counters.data_bytes == 1U);
+}
+
+/**
+  * @brief  Burst write and read of a decoded date and time, in both register layouts.
+  * @retval None
+  */
+static void test_date_time(void) {
+	static const uint8_t expected[DS1307_TIME_REG_COUNT] = { 0x00, 0x30, 0x14,
+			0x05, 0x13, 0x06, 0x25 };
+	const ds1307::date_time in { 2025, DS1307_JUNE, 13, DS1307_FRIDAY, 14, 30, 0 };
+	ds1307_sim_t sim;
+	test_rtc rtc(test_transport { &sim });
+	ds1307::date_time out { };
+
+	ds1307_sim_init(&sim);
+	TEST_CHECK(rtc.write(in) == DS1307_OK);
+	TEST_CHECK(std::memcmp(sim.regs, expected, sizeof(expected)) == 0);
+	TEST_CHECK(sim.counters.transactions == 1U
+			&& sim.counters.data_bytes == DS1307_TIME_REG_COUNT);
+	TEST_CHECK(rtc.read(out) == DS1307_OK);
+	TEST_CHECK(out.year == 2025U && out.month == DS1307_JUNE && out.date == 13U
+			&& out.day == DS1307_FRIDAY && out.hour == 14U && out.minute == 30U
+			&& out.second == 0U);
+
+	TEST_CHECK(rtc.write(in, DS1307_CLOCK_DISABLE) == DS1307_OK);
+	TEST_CHECK(sim.regs[DS1307_SEC_REG_ADR] == 0x80U);
+	TEST_CHECK(rtc.read(out) == DS1307_OK && out.second == 0U);
+
+	sim.regs[DS1307_HOUR_REG_ADR] = 0x62;
+	TEST_CHECK(rtc.read(out) == DS1307_OK && out.hour == 14U);
+	sim.regs[DS1307_HOUR_REG_ADR] = 0x52;
+	TEST_CHECK(rtc.read(out) == DS1307_OK && out.hour == 0U);
+
+	out.minute = 99;
+	sim.fail_count = 1;
+	TEST_CHECK(rtc.read(out) == DS1307_ERROR && out.minute == 99U);
+}
+
+/**
+  * @brief  std::chrono conversions, cross-checked with the C driver on the same model.
+  * @retval None
+  */
+static void test_chrono(void) {
+	const ds1307::time_point tp(std::chrono::seconds(1749825000L));
+	ds1307_sim_t sim;
+	test_rtc rtc(test_transport { &sim });
+	ds1307::time_point now;
+	ds1307_context_t ctx;
+
+	ds1307_sim_init(&sim);
+	TEST_CHECK(rtc.set(tp) == DS1307_OK);
+	TEST_CHECK(!(sim.regs[DS1307_SEC_REG_ADR] & 0x80U));
+	TEST_CHECK(rtc.now(now) == DS1307_OK && now == tp);
+
+	std::memset(&ctx, 0, sizeof(ctx));
+	ds1307_sim_bind(&ctx.functions, &sim);
+#if DS1307_CONFIG_CENTURY
+	ctx.century = 2000;
+#endif
+	TEST_CHECK(DS1307_read_date_time(&ctx) == DS1307_OK);
+	TEST_CHECK(ds1307_to_epoch(&ctx) == 1749825000UL);
+	TEST_CHECK(ctx.day == DS1307_FRIDAY && ctx.hour == 14U && ctx.minute == 30U);
+
+	ds1307_sim_tick(&sim);
+	TEST_CHECK(rtc.now(now) == DS1307_OK && now == tp + std::chrono::seconds(1));
+	sim.fail_count = 1;
+	TEST_CHECK(rtc.now(now) == DS1307_ERROR && now == tp + std::chrono::seconds(1));
+}
+
+/**
+  * @brief  Round trips of the wrapper: the BCD codec, every hour in both register layouts, and
+  *         every day from 2000 to 2099 through set(), now() and one tick of the model.
+  * @retval None
+  */
+static void test_round_trip(void) {
+	ds1307_sim_t sim;
+	test_rtc rtc(test_transport { &sim });
+	ds1307::date_time out { };
+	ds1307::time_point now;
+	uint32_t epoch;
+	uint8_t format;
+	uint8_t value;
+
+	for (value = 0; value < 100U; value++) {
+		TEST_CHECK(ds1307::to_bcd(value) == ((value / 10U) << 4 | value % 10U));
+		TEST_CHECK(ds1307::from_bcd(ds1307::to_bcd(value)) == value);
+	}
+
+	ds1307_sim_init(&sim);
+	for (format = DS1307_HOUR_FORMAT_12; format <= DS1307_HOUR_FORMAT_24; format++) {
+		for (value = 0; value < 24U; value++) {
+			const uint8_t raw = test_hour_reg(
+					static_cast<ds_1307_hour_format_t>(format), value);
+
+			TEST_CHECK(ds1307::raw_hour_to_24(raw) == value);
+			sim.regs[DS1307_HOUR_REG_ADR] = raw;
+			TEST_CHECK(rtc.read(out) == DS1307_OK && out.hour == value);
+		}
+	}
+	for (value = 0; value < 24U; value++) {
+		TEST_CHECK(rtc.set_hour(value) == DS1307_OK);
+		TEST_CHECK(sim.regs[DS1307_HOUR_REG_ADR]
+				== test_hour_reg(DS1307_HOUR_FORMAT_24, value));
+	}
+
+	/* 23:59:59 of every day; the tick after 2099-12-31 would need a year register of 100 */
+	for (epoch = DS1307_EPOCH_2000 + 86399UL; epoch + 1U < 4102444800UL;
+			epoch += 86400UL) {
+		const ds1307::time_point tp { std::chrono::seconds(epoch) };
+
+		TEST_CHECK(rtc.set(tp) == DS1307_OK);
+		TEST_CHECK(rtc.now(now) == DS1307_OK && now == tp);
+		ds1307_sim_tick(&sim);
+		TEST_CHECK(rtc.read(out) == DS1307_OK);
+		TEST_CHECK(ds1307::to_epoch(out) == epoch + 1U);
+		TEST_CHECK(out.day == ds1307::from_epoch(epoch + 1U).day);
+	}
+}
+
+/**
+  * @brief  Runs all tests.
+  * @retval 0 if every check passed, 1 otherwise.
+  */
+int main(void) {
+	test_registers();
+	test_date_time();
+	test_chrono();
+	test_round_trip();
+
+	std::printf("ds1307_hpp_test: %lu checks, %lu failures\n", test_checks,
+			test_failures);
+	return test_failures ? 1 : 0;
+}
@@ -0,0 +1,308 @@
+/**
+  ******************************************************************************
+  * @file    ds1307_sim.c
+  * @author  iek2443
+  * @brief   Source file for the simulated DS1307 used by the host builds.
+  *          Implements the register file, the BCD clock and the bus
+  *          accounting of the model.
+  ******************************************************************************
+  * @attention
+  *
+  * The clock is counted independently of the driver: the calendar below
+  * does not share any code with DS1307.c, so the tests can compare the two.
+  * A transfer sees the time as it was at its START condition, like the user
+  * buffers of the device, and the bus time of the transfer is added to the
+  * clock afterwards when run_clock is set.
+  *
+  ******************************************************************************
+  */
+#include "ds1307_sim.h"
+
+#include <string.h>
+
+static ds1307_status_t ds1307_sim_transfer(ds1307_sim_t *sim, uint8_t write,
+		ds1307_reg_adr_t reg_adr, uint8_t *data, uint16_t size);
+static uint8_t ds1307_sim_bcd(uint8_t value);
+static uint8_t ds1307_sim_dec(uint8_t bcd);
+static uint8_t ds1307_sim_month_days(uint8_t month, uint8_t year);
+
+/**
+  * @brief  Resets the model.
+  * @param  sim: Pointer to the model.
+  * @retval None
+  * @note   The clock is halted (CH = 1) at 2000-01-01 00:00:00, a Saturday (day register 6), in
+  *         24-hour layout. The RAM is cleared, the bus runs at 100 kHz with 9 clocks per byte and
+  *         one clock per START/STOP condition, and bus time does not advance the clock.
+  */
+void ds1307_sim_init(ds1307_sim_t *sim) {
+	memset(sim, 0, sizeof(*sim));
+	sim->regs[DS1307_SEC_REG_ADR] = 0x80;
+	sim->regs[DS1307_DAY_REG_ADR] = 0x06;
+	sim->regs[DS1307_DATE_REG_ADR] = 0x01;
+	sim->regs[DS1307_MONTH_REG_ADR] = 0x01;
+	sim->timing.bus_hz = 100000UL;
+	sim->timing.clocks_per_byte = 9;
+	sim->timing.clocks_per_condition = 1;
+}
+
+/**
+  * @brief  Sets the transport functions, handle and lock hooks of a driver configuration to the model.
+  * @param  functions: Pointer to the driver configuration (e.g. &ds1307.functions).
+  * @param  sim: Pointer to the model.
+  * @retval None
+  */
+void ds1307_sim_bind(ds1307_user_func_t *functions, ds1307_sim_t *sim) {
+	functions->ds1307_i2c_send_ptr = ds1307_sim_write;
+	functions->ds1307_i2c_read_ptr = ds1307_sim_read;
+	functions->handle = sim;
+	functions->lock = ds1307_sim_lock;
+	functions->unlock = ds1307_sim_unlock;
+}
+
+/**
+  * @brief  Memory write: START, address, register pointer, data, STOP.
+  * @param  handle: Pointer to the model.
+  * @param  address: 8-bit I2C address (ignored, the model answers any address).
+  * @param  reg_adr: First register address.
+  * @param  data: Data to write.
+  * @param  size: Number of bytes.
+  * @retval Status of the transfer.
+  */
+ds1307_status_t ds1307_sim_write(void *handle, ds1307_adr_t address,
+		ds1307_reg_adr_t reg_adr, uint8_t *data, uint16_t size) {
+	(void) address;
+	return ds1307_sim_transfer((ds1307_sim_t*) handle, 1, reg_adr, data, size);
+}
+
+/**
+  * @brief  Memory read: START, address, register pointer, repeated START, address, data, STOP.
+  * @param  handle: Pointer to the model.
+  * @param  address: 8-bit I2C address (ignored, the model answers any address).
+  * @param  reg_adr: First register address.
+  * @param  data: Destination buffer.
+  * @param  size: Number of bytes.
+  * @retval Status of the transfer.
+  */
+ds1307_status_t ds1307_sim_read(void *handle, ds1307_adr_t address,
+		ds1307_reg_adr_t reg_adr, uint8_t *data, uint16_t size) {
+	(void) address;
+	return ds1307_sim_transfer((ds1307_sim_t*) handle, 0, reg_adr, data, size);
+}
+
+/**
+  * @brief  Lock hook tracking the nesting depth.
+  * @param  handle: Pointer to the model.
+  * @retval None
+  */
+void ds1307_sim_lock(void *handle) {
+	((ds1307_sim_t*) handle)->lock_depth++;
+}
+
+/**
+  * @brief  Unlock hook tracking the nesting depth.
+  * @param  handle: Pointer to the model.
+  * @retval None
+  */
+void ds1307_sim_unlock(void *handle) {
+	((ds1307_sim_t*) handle)->lock_depth--;
+}
+
+/**
+  * @brief  Clears the bus usage counters.
+  * @param  sim: Pointer to the model.
+  * @retval None
+  */
+void ds1307_sim_reset_counters(ds1307_sim_t *sim) {
+	memset(&sim->counters, 0, sizeof(sim->counters));
+}
+
+/**
+  * @brief  Returns the SCL clocks of the counted traffic.
+  * @param  sim: Pointer to the model.
+  * @retval Clocks of all bytes and conditions since the last counter reset.
+  */
+uint32_t ds1307_sim_clocks(const ds1307_sim_t *sim) {
+	return sim->counters.bus_bytes * sim->timing.clocks_per_byte
+			+ sim->counters.conditions * sim->timing.clocks_per_condition;
+}
+
+/**
+  * @brief  Converts the counted traffic to bus time.
+  * @param  sim: Pointer to the model.
+  * @param  bus_hz: SCL frequency.
+  * @retval Bus time in microseconds, rounded to the nearest microsecond.
+  */
+uint32_t ds1307_sim_clocks_to_us(const ds1307_sim_t *sim, uint32_t bus_hz) {
+	return (uint32_t) (((uint64_t) ds1307_sim_clocks(sim) * 1000000UL
+			+ bus_hz / 2U) / bus_hz);
+}
+
+/**
+  * @brief  Advances the clock by a time in nanoseconds.
+  * @param  sim: Pointer to the model.
+  * @param  ns: Elapsed time.
+  * @retval None
+  * @note   Does nothing while the CH bit is set.
+  */
+void ds1307_sim_advance(ds1307_sim_t *sim, uint32_t ns) {
+	if (sim->regs[DS1307_SEC_REG_ADR] & 0x80U) {
+		return;
+	}
+	while (ns >= 1000000000UL - sim->phase_ns) {
+		ns -= 1000000000UL - sim->phase_ns;
+		sim->phase_ns = 0;
+		ds1307_sim_tick(sim);
+	}
+	sim->phase_ns += ns;
+}
+
+/**
+  * @brief  Advances the clock by one second.
+  * @param  sim: Pointer to the model.
+  * @retval None
+  * @note   Does nothing while the CH bit is set. Leap years are every fourth year, as on the device.
+  */
+void ds1307_sim_tick(ds1307_sim_t *sim) {
+	uint8_t *r = sim->regs;
+	uint8_t value;
+	uint8_t pm;
+
+	if (r[DS1307_SEC_REG_ADR] & 0x80U) {
+		return;
+	}
+	value = ds1307_sim_dec(r[DS1307_SEC_REG_ADR]) + 1U;
+	r[DS1307_SEC_REG_ADR] = ds1307_sim_bcd(value % 60U);
+	if (value < 60U) {
+		return;
+	}
+	value = ds1307_sim_dec(r[DS1307_MIN_REG_ADR]) + 1U;
+	r[DS1307_MIN_REG_ADR] = ds1307_sim_bcd(value % 60U);
+	if (value < 60U) {
+		return;
+	}
+
+	if (r[DS1307_HOUR_REG_ADR] & 0x40U) {
+		pm = r[DS1307_HOUR_REG_ADR] & 0x20U;
+		value = ds1307_sim_dec(r[DS1307_HOUR_REG_ADR] & 0x1FU);
+		if (value == 11U) {
+			r[DS1307_HOUR_REG_ADR] = (uint8_t) (0x40U | (pm ^ 0x20U) | 0x12U);
+			if (!pm) {
+				return;
+			}
+		} else {
+			r[DS1307_HOUR_REG_ADR] = (uint8_t) (0x40U | pm
+					| ds1307_sim_bcd((uint8_t) (value % 12U + 1U)));
+			return;
+		}
+	} else {
+		value = ds1307_sim_dec(r[DS1307_HOUR_REG_ADR] & 0x3FU) + 1U;
+		r[DS1307_HOUR_REG_ADR] = ds1307_sim_bcd(value % 24U);
+		if (value < 24U) {
+			return;
+		}
+	}
+
+	r[DS1307_DAY_REG_ADR] = (uint8_t) (r[DS1307_DAY_REG_ADR] % 7U + 1U);
+	value = ds1307_sim_dec(r[DS1307_DATE_REG_ADR]) + 1U;
+	if (value <= ds1307_sim_month_days(ds1307_sim_dec(r[DS1307_MONTH_REG_ADR]),
+			ds1307_sim_dec(r[DS1307_YEAR_REG_ADR]))) {
+		r[DS1307_DATE_REG_ADR] = ds1307_sim_bcd(value);
+		return;
+	}
+	r[DS1307_DATE_REG_ADR] = 0x01;
+	value = ds1307_sim_dec(r[DS1307_MONTH_REG_ADR]) + 1U;
+	if (value <= 12U) {
+		r[DS1307_MONTH_REG_ADR] = ds1307_sim_bcd(value);
+		return;
+	}
+	r[DS1307_MONTH_REG_ADR] = 0x01;
+	value = ds1307_sim_dec(r[DS1307_YEAR_REG_ADR]) + 1U;
+	r[DS1307_YEAR_REG_ADR] = ds1307_sim_bcd(value % 100U);
+}
+
+/**
+  * @brief  Runs one transfer through the register file and accounts it.
+  * @param  sim: Pointer to the model.
+  * @param  write: Non-zero for a write, zero for a read.
+  * @param  reg_adr: First register address.
+  * @param  data: Data buffer.
+  * @param  size: Number of bytes.
+  * @retval @ref DS1307_INVALID_PARAM for a transfer above max_transfer, @ref DS1307_ERROR while
+  *         fail_count is non-zero (the transfer is counted but has no effect), otherwise @ref DS1307_OK.
+  * @note   Writing the seconds register resets the divider chain, so the next second starts a full
+  *         second after the write.
+  */
+static ds1307_status_t ds1307_sim_transfer(ds1307_sim_t *sim, uint8_t write,
+		ds1307_reg_adr_t reg_adr, uint8_t *data, uint16_t size) {
+	uint32_t clocks = ds1307_sim_clocks(sim);
+	uint16_t i;
+
+	if (sim->max_transfer != 0 && size > sim->max_transfer) {
+		return DS1307_INVALID_PARAM;
+	}
+	sim->counters.transactions++;
+	sim->counters.data_bytes += size;
+	sim->counters.bus_bytes += size + (write ? 2U : 3U);
+	sim->counters.conditions += write ? 2U : 3U;
+	if (sim->lock_depth == 0) {
+		sim->counters.unlocked++;
+	}
+
+	if (sim->fail_count) {
+		sim->fail_count--;
+		return DS1307_ERROR;
+	}
+	sim->pointer = (uint8_t) ((uint8_t) reg_adr % DS1307_SIM_SIZE);
+	for (i = 0; i < size; i++) {
+		if (write) {
+			sim->regs[sim->pointer] = data[i];
+			if (sim->pointer == DS1307_SEC_REG_ADR) {
+				sim->phase_ns = 0;
+			}
+		} else {
+			data[i] = sim->regs[sim->pointer];
+		}
+		sim->pointer = (uint8_t) ((sim->pointer + 1U) % DS1307_SIM_SIZE);
+	}
+
+	if (sim->run_clock) {
+		clocks = ds1307_sim_clocks(sim) - clocks;
+		ds1307_sim_advance(sim, (uint32_t) ((uint64_t) clocks * 1000000000UL
+				/ sim->timing.bus_hz));
+	}
+	return DS1307_OK;
+}
+
+/**
+  * @brief  Converts a decimal value (0–99) to BCD.
+  * @param  value: Decimal value.
+  * @retval BCD value.
+  */
+static uint8_t ds1307_sim_bcd(uint8_t value) {
+	return (uint8_t) (((value / 10U) << 4) | (value % 10U));
+}
+
+/**
+  * @brief  Converts a BCD value to decimal.
+  * @param  bcd: BCD value.
+  * @retval Decimal value.
+  */
+static uint8_t ds1307_sim_dec(uint8_t bcd) {
+	return (uint8_t) ((bcd >> 4) * 10U + (bcd & 0x0FU));
+}
+
+/**
+  * @brief  Returns the number of days of a month.
+  * @param  month: Month (1–12).
+  * @param  year: Two-digit year (0–99).
+  * @retval Number of days.
+  */
+static uint8_t ds1307_sim_month_days(uint8_t month, uint8_t year) {
+	static const uint8_t days[12] = { 31, 28, 31, 30, 31, 30, 31, 31, 30, 31,
+			30, 31 };
+
+	if (month == 2U && (year % 4U) == 0U) {
+		return 29;
+	}
+	return days[(month - 1U) % 12U];
+}
@@ -0,0 +1,131 @@
+/**
+  ******************************************************************************
+  * @file    ds1307_sim.h
+  * @author  iek2443
+  * @brief   Header file for the simulated DS1307 used by the host builds.
+  *          Contains the device model structure and the transport functions
+  *          that plug it into ds1307_user_func_t.
+  ******************************************************************************
+  * @attention
+  *
+  * The model keeps the 64-byte register file of the device (timekeeping,
+  * control and RAM) with an auto-incrementing register pointer that wraps
+  * from 0x3F to 0x00. The clock counts in BCD like the device, 12-hour and
+  * 24-hour layouts included, and stops while the CH bit is set. Every
+  * transfer is accounted with a configurable per-byte bus timing, and the
+  * modelled bus time can be made to advance the clock.
+  *
+  ******************************************************************************
+  */
+
+#ifndef INC_DS1307_SIM_H_
+#define INC_DS1307_SIM_H_
+
+#include "DS1307.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief  Size of the register file (registers 0x00–0x07 and the RAM).
+ */
+#define DS1307_SIM_SIZE		64U
+
+/**
+ * @brief  Bus timing of the model.
+ */
+typedef struct {
+	uint32_t bus_hz; /*!< SCL frequency, used to convert clocks to time */
+	uint8_t clocks_per_byte; /*!< SCL clocks per byte including the ACK bit (9 on I2C) */
+	uint8_t clocks_per_condition; /*!< SCL clocks per START, repeated START or STOP condition */
+} ds1307_sim_timing_t;
+
+/**
+ * @brief  Bus usage counters of the model.
+ */
+typedef struct {
+	uint32_t transactions; /*!< Transport calls */
+	uint32_t data_bytes; /*!< Data bytes carried by the calls */
+	uint32_t bus_bytes; /*!< Bytes on the bus: data plus address and register pointer bytes */
+	uint32_t conditions; /*!< START, repeated START and STOP conditions */
+	uint32_t unlocked; /*!< Transport calls made while the bus lock was not held */
+} ds1307_sim_counters_t;
+
+/**
+ * @brief  Simulated DS1307 device.
+ */
+typedef struct {
+	uint8_t regs[DS1307_SIM_SIZE]; /*!< Register file */
+	uint8_t pointer; /*!< Register pointer */
+	ds1307_sim_timing_t timing; /*!< Bus timing */
+	ds1307_sim_counters_t counters; /*!< Bus usage since the last reset */
+	uint8_t run_clock; /*!< Non-zero: the modelled bus time advances the clock */
+	uint32_t phase_ns; /*!< Position within the current second */
+	uint16_t max_transfer; /*!< Largest accepted transfer in bytes (0 = no limit) */
+	uint8_t fail_count; /*!< Number of following transfers that fail with DS1307_ERROR */
+	uint8_t lock_depth; /*!< Nesting depth of the bus lock */
+} ds1307_sim_t;
+
+/**
+ * @brief  Resets the model: clock halted at 2000-01-01 00:00:00 (Saturday), 24-hour layout, 100 kHz bus.
+ */
+void ds1307_sim_init(ds1307_sim_t *sim);
+
+/**
+ * @brief  Sets the transport functions, handle and lock hooks of a driver configuration to the model.
+ */
+void ds1307_sim_bind(ds1307_user_func_t *functions, ds1307_sim_t *sim);
+
+/**
+ * @brief  Transport write function (@ref ds1307_i2c_mem_write_func_t); the handle is a ds1307_sim_t.
+ */
+ds1307_status_t ds1307_sim_write(void *handle, ds1307_adr_t address,
+		ds1307_reg_adr_t reg_adr, uint8_t *data, uint16_t size);
+
+/**
+ * @brief  Transport read function (@ref ds1307_i2c_mem_read_func_t); the handle is a ds1307_sim_t.
+ */
+ds1307_status_t ds1307_sim_read(void *handle, ds1307_adr_t address,
+		ds1307_reg_adr_t reg_adr, uint8_t *data, uint16_t size);
+
+/**
+ * @brief  Lock hook (@ref ds1307_lock_func_t) tracking the nesting depth.
+ */
+void ds1307_sim_lock(void *handle);
+
+/**
+ * @brief  Unlock hook (@ref ds1307_lock_func_t) tracking the nesting depth.
+ */
+void ds1307_sim_unlock(void *handle);
+
+/**
+ * @brief  Clears the bus usage counters.
+ */
+void ds1307_sim_reset_counters(ds1307_sim_t *sim);
+
+/**
+ * @brief  Converts SCL clocks counted by the model to microseconds at a bus frequency.
+ */
+uint32_t ds1307_sim_clocks_to_us(const ds1307_sim_t *sim, uint32_t bus_hz);
+
+/**
+ * @brief  Returns the SCL clocks of the counted traffic.
+ */
+uint32_t ds1307_sim_clocks(const ds1307_sim_t *sim);
+
+/**
+ * @brief  Advances the clock by one second unless the oscillator is halted.
+ */
+void ds1307_sim_tick(ds1307_sim_t *sim);
+
+/**
+ * @brief  Advances the clock by a time in nanoseconds unless the oscillator is halted.
+ */
+void ds1307_sim_advance(ds1307_sim_t *sim, uint32_t ns);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_DS1307_SIM_H_ */
@@ -0,0 +1,1468 @@
+/**
+  ******************************************************************************
+  * @file    ds1307_test.c
+  * @author  iek2443
+  * @brief   Host property and behaviour tests of the DS1307 driver.
+  *          Round-trips the BCD codec, the 12H/24H hour encoding and the
+  *          calendar through the simulated DS1307, and runs the bus, NVRAM,
+  *          journal, alarm, time zone and scheduler layers against it.
+  ******************************************************************************
+  * @attention
+  *
+  * Expected register values are computed here independently of DS1307.c,
+  * and the calendar is checked against the clock of the model, which does
+  * not share code with the driver. "make test" builds and runs this file
+  * once per BCD codec backend.
+  *
+  ******************************************************************************
+  */
+#include <stdio.h>
+#include <string.h>
+
+#include "DS1307.h"
+#include "DS1307_alarm.h"
+#include "DS1307_cache.h"
+#include "DS1307_calib.h"
+#include "DS1307_format.h"
+#include "DS1307_journal.h"
+#include "DS1307_mux.h"
+#include "DS1307_sched.h"
+#include "DS1307_tz.h"
+#include "ds1307_sim.h"
+
+#define TEST_CHECK(cond)	test_check((cond) != 0, __LINE__, #cond)
+
+static unsigned long test_checks;
+static unsigned long test_failures;
+static uint32_t test_ms;
+static uint8_t test_mux_channel;
+static uint8_t test_mux_unlocked;
+static uint8_t test_writes_left = 0xFF;
+static uint8_t test_alarm_ids[16];
+static uint32_t test_alarm_deadlines[16];
+static uint8_t test_alarm_count;
+static uint32_t test_delays[4];
+static uint8_t test_delay_count;
+
+/**
+ * @brief  Transfer recorded by the asynchronous test transport.
+ */
+static struct {
+	ds1307_async_dir_t dir; /*!< Direction of the recorded transfer */
+	ds1307_adr_t address; /*!< Device address */
+	ds1307_reg_adr_t reg_adr; /*!< First register */
+	uint8_t *data; /*!< Transfer buffer of the driver */
+	uint16_t size; /*!< Number of bytes */
+	uint8_t polls; /*!< Polls answered with DS1307_BUSY before the transfer runs */
+	ds1307_status_t result; /*!< Result of the start function */
+	uint8_t done; /*!< Completion callbacks so far */
+	ds1307_status_t status; /*!< Status of the last completion callback */
+} test_async;
+
+/**
+  * @brief  Records the result of one check and reports the first failures.
+  * @param  ok: Non-zero if the check passed.
+  * @param  line: Source line of the check.
+  * @param  text: Text of the checked expression.
+  * @retval Non-zero if the check passed.
+  */
+static int test_check(int ok, int line, const char *text) {
+	test_checks++;
+	if (!ok) {
+		test_failures++;
+		if (test_failures <= 20U) {
+			printf("ds1307_test.c:%d: check failed: %s\n", line, text);
+		}
+	}
+	return ok;
+}
+
+/**
+  * @brief  Reference decimal to BCD conversion.
+  * @param  value: Decimal value (0–99).
+  * @retval BCD value.
+  */
+static uint8_t test_bcd(uint8_t value) {
+	return (uint8_t) (((value / 10U) << 4) | (value % 10U));
+}
+
+/**
+  * @brief  Reference encoding of the hours register.
+  * @param  format: Hour format of the register layout.
+  * @param  hour: Hour in 24-hour notation (0–23).
+  * @retval Register value.
+  */
+static uint8_t test_hour_reg(ds_1307_hour_format_t format, uint8_t hour) {
+	uint8_t h12 = (uint8_t) (hour % 12U);
+
+	if (format == DS1307_HOUR_FORMAT_24) {
+		return test_bcd(hour);
+	}
+	return (uint8_t) (0x40U | ((hour >= 12U) ? 0x20U : 0U)
+			| test_bcd(h12 ? h12 : 12U));
+}
+
+/**
+  * @brief  Returns the hour of a decoded context in 24-hour notation, checking the AM/PM fields.
+  * @param  rtc: Pointer to the context.
+  * @retval Hour (0–23), or 0xFF if the fields are inconsistent.
+  */
+static uint8_t test_hour_24(const ds1307_context_t *rtc) {
+	if (rtc->time_format == DS1307_HOUR_FORMAT_24) {
+		return (rtc->time_period == DS1307_NONE && rtc->hour < 24U) ?
+				rtc->hour : 0xFFU;
+	}
+	if (rtc->hour < 1U || rtc->hour > 12U || rtc->time_period == DS1307_NONE) {
+		return 0xFFU;
+	}
+	return (uint8_t) (rtc->hour % 12U + ((rtc->time_period == DS1307_PM) ? 12U : 0U));
+}
+
+/**
+  * @brief  Small linear congruential generator for the fuzz loops.
+  * @param  state: Generator state.
+  * @retval Next pseudo-random value.
+  */
+static uint32_t test_random(uint32_t *state) {
+	*state = *state * 1664525UL + 1013904223UL;
+	return *state >> 8;
+}
+
+/**
+  * @brief  Millisecond tick of the cache tests (@ref ds1307_tick_func_t).
+  * @retval Value of test_ms.
+  */
+static uint32_t test_tick_ms(void) {
+	return test_ms;
+}
+
+/**
+  * @brief  Multiplexer select function of the mux tests (@ref ds1307_mux_select_func_t).
+  * @param  mux_handle: The model.
+  * @param  channel: Channel to select.
+  * @retval DS1307_OK
+  * @note   Records the channel and counts the selects made without the bus lock held. The seconds
+  *         register of the model is set to the channel number, so each device reads differently.
+  */
+static ds1307_status_t test_mux_select(void *mux_handle, uint8_t channel) {
+	ds1307_sim_t *sim = (ds1307_sim_t*) mux_handle;
+
+	test_mux_channel = channel;
+	sim->regs[DS1307_SEC_REG_ADR] = test_bcd(channel);
+	if (sim->lock_depth == 0U) {
+		test_mux_unlocked++;
+	}
+	return DS1307_OK;
+}
+
+/**
+  * @brief  Transport write function that fails one transfer (@ref ds1307_i2c_mem_write_func_t).
+  * @param  handle: The model.
+  * @param  address: Device address.
+  * @param  reg_adr: First register.
+  * @param  data: Bytes to write.
+  * @param  size: Number of bytes.
+  * @retval DS1307_ERROR for the write after test_writes_left more, otherwise the result of the model.
+  * @note   A test_writes_left of 0xFF never fails. The failed write has no effect on the model.
+  */
+static ds1307_status_t test_flaky_write(void *handle, ds1307_adr_t address,
+		ds1307_reg_adr_t reg_adr, uint8_t *data, uint16_t size) {
+	if (test_writes_left == 0U) {
+		test_writes_left = 0xFF;
+		return DS1307_ERROR;
+	}
+	if (test_writes_left != 0xFFU) {
+		test_writes_left--;
+	}
+	return ds1307_sim_write(handle, address, reg_adr, data, size);
+}
+
+/**
+  * @brief  Resets the model and binds a zeroed context to it.
+  * @param  rtc: Pointer to the context.
+  * @param  sim: Pointer to the model.
+  * @retval None
+  */
+static void test_setup(ds1307_context_t *rtc, ds1307_sim_t *sim) {
+	ds1307_sim_init(sim);
+	sim->regs[DS1307_SEC_REG_ADR] = 0x00;
+	memset(rtc, 0, sizeof(*rtc));
+	ds1307_sim_bind(&rtc->functions, sim);
+#if DS1307_CONFIG_CENTURY
+	rtc->century = 2000;
+#endif
+}
+
+/**
+  * @brief  Every decimal value through the setters and getters, and every BCD byte through the decoders.
+  * @retval None
+  */
+static void test_bcd_codec(void) {
+	ds1307_context_t rtc;
+	ds1307_sim_t sim;
+	uint8_t v;
+
+	test_setup(&rtc, &sim);
+	for (v = 0; v < 100U; v++) {
+		TEST_CHECK(ds1307_set_year(&rtc, (uint16_t) (2000U + v)) == DS1307_OK);
+		TEST_CHECK(sim.regs[DS1307_YEAR_REG_ADR] == test_bcd(v));
+		sim.regs[DS1307_MIN_REG_ADR] = test_bcd(v);
+		TEST_CHECK(ds1307_get_minute(&rtc) == DS1307_OK && rtc.minute == v);
+		TEST_CHECK(ds1307_get_year(&rtc) == DS1307_OK
+				&& rtc.year == 2000U + v);
+	}
+	for (v = 0; v < 60U; v++) {
+		sim.regs[DS1307_SEC_REG_ADR] = (uint8_t) (0x80U | test_bcd(v));
+		TEST_CHECK(ds1307_get_second(&rtc) == DS1307_OK && rtc.second == v);
+		TEST_CHECK(ds1307_set_second(&rtc, v) == DS1307_OK
+				&& sim.regs[DS1307_SEC_REG_ADR] == test_bcd(v));
+		TEST_CHECK(ds1307_set_minute(&rtc, v) == DS1307_OK
+				&& sim.regs[DS1307_MIN_REG_ADR] == test_bcd(v));
+	}
+	for (v = 1; v <= 31U; v++) {
+		TEST_CHECK(ds1307_set_date(&rtc, v) == DS1307_OK
+				&& sim.regs[DS1307_DATE_REG_ADR] == test_bcd(v));
+	}
+	for (v = 1; v <= 12U; v++) {
+		TEST_CHECK(ds1307_set_month(&rtc, (ds1307_month_t) v) == DS1307_OK
+				&& sim.regs[DS1307_MONTH_REG_ADR] == test_bcd(v));
+	}
+}
+
+/**
+  * @brief  Random valid register images through the burst decoder and the burst encoder.
+  * @retval None
+  */
+static void test_image_fuzz(void) {
+	ds1307_context_t rtc;
+	ds1307_sim_t sim;
+	uint8_t image[DS1307_TIME_REG_COUNT];
+	uint32_t seed = 0x1307U;
+	uint32_t n;
+	uint8_t hour;
+	uint8_t i;
+
+	test_setup(&rtc, &sim);
+	for (n = 0; n < 100000UL; n++) {
+		hour = (uint8_t) (test_random(&seed) % 24U);
+		image[DS1307_SEC_REG_ADR] = test_bcd((uint8_t) (test_random(&seed) % 60U));
+		image[DS1307_MIN_REG_ADR] = test_bcd((uint8_t) (test_random(&seed) % 60U));
+		image[DS1307_HOUR_REG_ADR] = test_hour_reg(
+				(ds_1307_hour_format_t) (test_random(&seed) & 1U), hour);
+		image[DS1307_DAY_REG_ADR] = (uint8_t) (test_random(&seed) % 7U + 1U);
+		image[DS1307_DATE_REG_ADR] = test_bcd((uint8_t) (test_random(&seed) % 31U + 1U));
+		image[DS1307_MONTH_REG_ADR] = test_bcd((uint8_t) (test_random(&seed) % 12U + 1U));
+		image[DS1307_YEAR_REG_ADR] = test_bcd((uint8_t) (test_random(&seed) % 100U));
+		memcpy(sim.regs, image, sizeof(image));
+
+		TEST_CHECK(DS1307_read_date_time(&rtc) == DS1307_OK);
+		TEST_CHECK(test_bcd(rtc.second) == image[DS1307_SEC_REG_ADR]);
+		TEST_CHECK(test_bcd(rtc.minute) == image[DS1307_MIN_REG_ADR]);
+		TEST_CHECK(test_hour_24(&rtc) == hour);
+		TEST_CHECK(test_hour_reg(rtc.time_format, hour) == image[DS1307_HOUR_REG_ADR]);
+		TEST_CHECK((uint8_t) rtc.day == image[DS1307_DAY_REG_ADR]);
+		TEST_CHECK(test_bcd(rtc.date) == image[DS1307_DATE_REG_ADR]);
+		TEST_CHECK(test_bcd((uint8_t) rtc.month) == image[DS1307_MONTH_REG_ADR]);
+		TEST_CHECK(test_bcd((uint8_t) (rtc.year - 2000U)) == image[DS1307_YEAR_REG_ADR]);
+
+		for (i = 0; i < DS1307_TIME_REG_COUNT; i++) {
+			TEST_CHECK(rtc.regs[i] == image[i]);
+		}
+	}
+}
+
+/**
+  * @brief  Encode fuzz: random decoded fields burst-written with ds1307_set_date_time must reach the
+  *         model as the reference BCD image, through every lane of the selected codec.
+  * @retval None
+  */
+static void test_encode_fuzz(void) {
+	ds1307_context_t rtc;
+	ds1307_sim_t sim;
+	uint8_t image[DS1307_TIME_REG_COUNT];
+	uint32_t seed = 0x2443U;
+	uint32_t n;
+	uint8_t hour;
+	uint8_t i;
+
+	test_setup(&rtc, &sim);
+	for (n = 0; n < 100000UL; n++) {
+		hour = (uint8_t) (test_random(&seed) % 24U);
+		rtc.time_format = (ds_1307_hour_format_t) (test_random(&seed) & 1U);
+		if (rtc.time_format == DS1307_HOUR_FORMAT_24) {
+			rtc.hour = hour;
+			rtc.time_period = DS1307_NONE;
+		} else {
+			rtc.hour = (uint8_t) (hour % 12U ? hour % 12U : 12U);
+			rtc.time_period = hour >= 12U ? DS1307_PM : DS1307_AM;
+		}
+		rtc.second = (uint8_t) (test_random(&seed) % 60U);
+		rtc.minute = (uint8_t) (test_random(&seed) % 60U);
+		rtc.day = (ds1307_day_t) (test_random(&seed) % 7U + 1U);
+		rtc.date = (uint8_t) (test_random(&seed) % 31U + 1U);
+		rtc.month = (ds1307_month_t) (test_random(&seed) % 12U + 1U);
+		rtc.year = (uint16_t) (2000U + test_random(&seed) % 100U);
+
+		image[DS1307_SEC_REG_ADR] = test_bcd(rtc.second);
+		image[DS1307_MIN_REG_ADR] = test_bcd(rtc.minute);
+		image[DS1307_HOUR_REG_ADR] = test_hour_reg(rtc.time_format, hour);
+		image[DS1307_DAY_REG_ADR] = (uint8_t) rtc.day;
+		image[DS1307_DATE_REG_ADR] = test_bcd(rtc.date);
+		image[DS1307_MONTH_REG_ADR] = test_bcd((uint8_t) rtc.month);
+		image[DS1307_YEAR_REG_ADR] = test_bcd((uint8_t) (rtc.year - 2000U));
+
+		TEST_CHECK(ds1307_set_date_time(&rtc) == DS1307_OK);
+		for (i = 0; i < DS1307_TIME_REG_COUNT; i++) {
+			TEST_CHECK(sim.regs[i] == image[i]);
+			TEST_CHECK(rtc.regs[i] == image[i]);
+		}
+	}
+}
+
+/**
+  * @brief  Every hour in both formats through ds1307_set_hour and ds1307_get_hour.
+  * @retval None
+  * @note   Covers the 12H encoding of midnight (0x52) and noon (0x72).
+  */
+static void test_hour_round_trip(void) {
+	ds1307_context_t rtc;
+	ds1307_compact_t time;
+	ds1307_sim_t sim;
+	uint8_t format;
+	uint8_t hour;
+
+	test_setup(&rtc, &sim);
+	for (format = 0; format < 2U; format++) {
+		for (hour = 0; hour < 24U; hour++) {
+			rtc.time_format = (ds_1307_hour_format_t) format;
+			TEST_CHECK(ds1307_set_hour(&rtc, hour) == DS1307_OK);
+			TEST_CHECK(sim.regs[DS1307_HOUR_REG_ADR]
+					== test_hour_reg((ds_1307_hour_format_t) format, hour));
+			TEST_CHECK(ds1307_get_hour(&rtc) == DS1307_OK);
+			TEST_CHECK(rtc.time_format == (ds_1307_hour_format_t) format);
+			TEST_CHECK(test_hour_24(&rtc) == hour);
+			TEST_CHECK(ds1307_compact_read(&rtc, &time) == DS1307_OK
+					&& ds1307_compact_hour(&time) == hour);
+		}
+	}
+	rtc.time_format = DS1307_HOUR_FORMAT_12;
+	TEST_CHECK(ds1307_set_hour(&rtc, 0) == DS1307_OK
+			&& sim.regs[DS1307_HOUR_REG_ADR] == 0x52U);
+	TEST_CHECK(ds1307_set_hour(&rtc, 12) == DS1307_OK
+			&& sim.regs[DS1307_HOUR_REG_ADR] == 0x72U);
+}
+
+/**
+  * @brief  Every hour in both formats read from the device and written back unchanged.
+  * @retval None
+  * @note   In 12-hour format the read leaves usr->hour at 1–12 with usr->time_period, so
+  *         ds1307_set_date_time, ds1307_compact_pack and ds1307_from_epoch must honour the
+  *         period (3 PM stays 0x63 instead of becoming 3 AM, 0x43).
+  */
+static void test_write_back(void) {
+	ds1307_context_t rtc;
+	ds1307_compact_t time;
+	ds1307_sim_t sim;
+	uint8_t format;
+	uint8_t hour;
+	uint8_t reg;
+
+	for (format = 0; format < 2U; format++) {
+		for (hour = 0; hour < 24U; hour++) {
+			reg = test_hour_reg((ds_1307_hour_format_t) format, hour);
+			test_setup(&rtc, &sim);
+			sim.regs[DS1307_HOUR_REG_ADR] = reg;
+			sim.regs[DS1307_DATE_REG_ADR] = 0x01;
+			sim.regs[DS1307_MONTH_REG_ADR] = 0x01;
+			TEST_CHECK(DS1307_read_date_time(&rtc) == DS1307_OK);
+			sim.regs[DS1307_HOUR_REG_ADR] = 0x00;
+			TEST_CHECK(ds1307_set_date_time(&rtc) == DS1307_OK);
+			TEST_CHECK(sim.regs[DS1307_HOUR_REG_ADR] == reg);
+			ds1307_compact_pack(&rtc, &time);
+			TEST_CHECK(time.regs[DS1307_HOUR_REG_ADR] == reg);
+
+			ds1307_from_epoch(&rtc, DS1307_EPOCH_2000 + hour * 3600UL);
+			sim.regs[DS1307_HOUR_REG_ADR] = 0x00;
+			TEST_CHECK(ds1307_set_date_time(&rtc) == DS1307_OK);
+			TEST_CHECK(sim.regs[DS1307_HOUR_REG_ADR] == reg);
+		}
+	}
+	rtc.time_format = DS1307_HOUR_FORMAT_12;
+	rtc.hour = 3;
+	rtc.time_period = DS1307_PM;
+	TEST_CHECK(ds1307_set_date_time(&rtc) == DS1307_OK
+			&& sim.regs[DS1307_HOUR_REG_ADR] == 0x63U);
+}
+
+/**
+  * @brief  Every hour converted between the formats by ds1307_set_time_format.
+  * @retval None
+  * @note   Also checks the hour rollover during the conversion at xx:59:59, and that a failed
+  *         write leaves the hour register and usr->time_format unchanged.
+  */
+static void test_time_format(void) {
+	ds1307_context_t rtc;
+	ds1307_sim_t sim;
+	uint8_t from;
+	uint8_t to;
+	uint8_t hour;
+
+	for (from = 0; from < 2U; from++) {
+		for (to = 0; to < 2U; to++) {
+			for (hour = 0; hour < 24U; hour++) {
+				test_setup(&rtc, &sim);
+				sim.regs[DS1307_MIN_REG_ADR] = 0x30;
+				sim.regs[DS1307_HOUR_REG_ADR] = test_hour_reg(
+						(ds_1307_hour_format_t) from, hour);
+				TEST_CHECK(ds1307_set_time_format(&rtc,
+						(ds_1307_hour_format_t) to) == DS1307_OK);
+				TEST_CHECK(sim.regs[DS1307_HOUR_REG_ADR]
+						== test_hour_reg((ds_1307_hour_format_t) to, hour));
+				TEST_CHECK(sim.regs[DS1307_MIN_REG_ADR] == 0x30U);
+				TEST_CHECK(test_hour_24(&rtc) == hour);
+
+				test_setup(&rtc, &sim);
+				sim.regs[DS1307_SEC_REG_ADR] = 0x59;
+				sim.regs[DS1307_MIN_REG_ADR] = 0x59;
+				sim.regs[DS1307_HOUR_REG_ADR] = test_hour_reg(
+						(ds_1307_hour_format_t) from, hour);
+				sim.phase_ns = 999900000UL;
+				sim.run_clock = 1;
+				TEST_CHECK(ds1307_set_time_format(&rtc,
+						(ds_1307_hour_format_t) to) == DS1307_OK);
+				TEST_CHECK(sim.regs[DS1307_HOUR_REG_ADR]
+						== test_hour_reg((ds_1307_hour_format_t) to,
+								(uint8_t) ((hour + 1U) % 24U)));
+				TEST_CHECK(sim.regs[DS1307_MIN_REG_ADR] == 0x00U);
+
+				if (from != to) {
+					test_setup(&rtc, &sim);
+					sim.regs[DS1307_HOUR_REG_ADR] = test_hour_reg(
+							(ds_1307_hour_format_t) from, hour);
+					TEST_CHECK(ds1307_get_hour(&rtc) == DS1307_OK);
+					sim.fail_count = 2;
+					sim.counters.transactions = 0;
+					rtc.functions.retries = 0;
+					TEST_CHECK(ds1307_set_time_format(&rtc,
+							(ds_1307_hour_format_t) to) == DS1307_ERROR);
+					sim.fail_count = 0;
+					TEST_CHECK(sim.regs[DS1307_HOUR_REG_ADR]
+							== test_hour_reg((ds_1307_hour_format_t) from, hour));
+					TEST_CHECK(rtc.time_format == (ds_1307_hour_format_t) from);
+				}
+			}
+		}
+	}
+}
+
+/**
+  * @brief  Every day from 2000 to 2099 through the epoch conversions, the burst write and the tick.
+  * @retval None
+  * @note   The context is set to 23:59:59 of each day with ds1307_from_epoch and written with
+  *         ds1307_set_date_time. One second later, the model and ds1307_tick must agree on the
+  *         next day, in 24-hour and (after ds1307_set_time_format) in 12-hour layout.
+  */
+static void test_calendar(void) {
+	static const uint8_t month_days[12] = { 31, 28, 31, 30, 31, 30, 31, 31, 30,
+			31, 30, 31 };
+	ds1307_context_t rtc;
+	ds1307_context_t back;
+	ds1307_sim_t sim;
+	uint32_t epoch;
+	uint32_t n = 0;
+	uint8_t year;
+	uint8_t month;
+	uint8_t date;
+	uint8_t days;
+	uint8_t format;
+
+	for (year = 0; year < 100U; year++) {
+		for (month = 1; month <= 12U; month++) {
+			days = (uint8_t) (month_days[month - 1U]
+					+ (month == 2U && year % 4U == 0U));
+			for (date = 1; date <= days; date++, n++) {
+				epoch = DS1307_EPOCH_2000 + n * 86400UL + 86399UL;
+				for (format = 0; format < 2U; format++) {
+					test_setup(&rtc, &sim);
+					ds1307_from_epoch(&rtc, epoch);
+					TEST_CHECK(rtc.year == 2000U + year && rtc.month == month
+							&& rtc.date == date);
+					TEST_CHECK((uint8_t) rtc.day == (n + 5U) % 7U + 1U);
+					TEST_CHECK(rtc.hour == 23U && rtc.minute == 59U
+							&& rtc.second == 59U);
+					TEST_CHECK(ds1307_to_epoch(&rtc) == epoch);
+					TEST_CHECK(ds1307_set_date_time(&rtc) == DS1307_OK);
+					TEST_CHECK(sim.regs[DS1307_YEAR_REG_ADR] == test_bcd(year)
+							&& sim.regs[DS1307_MONTH_REG_ADR] == test_bcd(month)
+							&& sim.regs[DS1307_DATE_REG_ADR] == test_bcd(date)
+							&& sim.regs[DS1307_HOUR_REG_ADR] == 0x23U);
+
+					if (format == DS1307_HOUR_FORMAT_12) {
+						TEST_CHECK(ds1307_set_time_format(&rtc,
+								DS1307_HOUR_FORMAT_12) == DS1307_OK);
+						TEST_CHECK(sim.regs[DS1307_HOUR_REG_ADR] == 0x71U);
+					}
+					ds1307_sim_tick(&sim);
+					ds1307_tick(&rtc);
+
+					back = rtc;
+					TEST_CHECK(DS1307_read_date_time(&back) == DS1307_OK);
+					TEST_CHECK(back.second == rtc.second && back.minute == rtc.minute
+							&& back.hour == rtc.hour && back.day == rtc.day
+							&& back.date == rtc.date && back.month == rtc.month
+							&& back.year == rtc.year
+							&& back.time_format == rtc.time_format
+							&& back.time_period == rtc.time_period);
+					TEST_CHECK(memcmp(back.regs, rtc.regs, sizeof(rtc.regs)) == 0);
+					TEST_CHECK(test_hour_24(&back) == 0U);
+					TEST_CHECK(ds1307_to_epoch(&back) == epoch + 1U);
+				}
+			}
+		}
+	}
+	TEST_CHECK(n == 36525UL);
+}
+
+/**
+  * @brief  Epoch conversions and ticks on a context loaded with ds1307_read_raw.
+  * @retval None
+  * @note   The fields are still pending after the raw read: ds1307_to_epoch must decode them,
+  *         and ds1307_tick must keep usr->regs and the decoded bitmap in step with the fields.
+  */
+static void test_lazy_epoch(void) {
+	ds1307_context_t rtc;
+	ds1307_context_t ref;
+	ds1307_sim_t sim;
+	uint8_t format;
+
+	for (format = 0; format < 2U; format++) {
+		test_setup(&rtc, &sim);
+		rtc.time_format = (ds_1307_hour_format_t) (1U - format);
+		sim.regs[DS1307_SEC_REG_ADR] = 0xD9; /* 59 s, halted */
+		sim.regs[DS1307_MIN_REG_ADR] = 0x59;
+		sim.regs[DS1307_HOUR_REG_ADR] = test_hour_reg((ds_1307_hour_format_t) format, 23);
+		sim.regs[DS1307_DAY_REG_ADR] = 0x04;
+		sim.regs[DS1307_DATE_REG_ADR] = 0x31;
+		sim.regs[DS1307_MONTH_REG_ADR] = 0x12;
+		sim.regs[DS1307_YEAR_REG_ADR] = 0x99;
+		ref = rtc;
+		TEST_CHECK(DS1307_read_date_time(&ref) == DS1307_OK);
+
+		TEST_CHECK(ds1307_read_raw(&rtc) == DS1307_OK);
+		TEST_CHECK(ds1307_to_epoch(&rtc) == ds1307_to_epoch(&ref));
+		TEST_CHECK(ds1307_to_epoch(&rtc) == 4102444799UL);
+		TEST_CHECK(rtc.decoded == 0U);
+
+		ds1307_tick(&rtc);
+		TEST_CHECK(rtc.decoded == DS1307_FIELD_ALL);
+		TEST_CHECK(rtc.year == 2100U && rtc.month == DS1307_JANUARY && rtc.date == 1U
+				&& rtc.second == 0U && rtc.minute == 0U);
+		TEST_CHECK(rtc.time_format == (ds_1307_hour_format_t) format);
+		TEST_CHECK(test_hour_24(&rtc) == 0U);
+		TEST_CHECK(rtc.regs[DS1307_SEC_REG_ADR] == 0x80U);
+		TEST_CHECK(rtc.regs[DS1307_HOUR_REG_ADR]
+				== test_hour_reg((ds_1307_hour_format_t) format, 0));
+		TEST_CHECK(rtc.regs[DS1307_YEAR_REG_ADR] == 0x00U
+				&& rtc.regs[DS1307_MONTH_REG_ADR] == 0x01U
+				&& rtc.regs[DS1307_DATE_REG_ADR] == 0x01U
+				&& rtc.regs[DS1307_DAY_REG_ADR] == 0x05U);
+
+		rtc = ref;
+		TEST_CHECK(ds1307_read_raw(&rtc) == DS1307_OK);
+		ds1307_add_seconds(&rtc, 3600);
+		TEST_CHECK(rtc.regs[DS1307_SEC_REG_ADR] == 0xD9U
+				&& rtc.regs[DS1307_MIN_REG_ADR] == 0x59U);
+		TEST_CHECK(rtc.regs[DS1307_HOUR_REG_ADR]
+				== test_hour_reg((ds_1307_hour_format_t) format, 0));
+		TEST_CHECK(rtc.regs[DS1307_DATE_REG_ADR] == 0x01U
+				&& rtc.regs[DS1307_YEAR_REG_ADR] == 0x00U);
+		TEST_CHECK(ds1307_to_epoch(&rtc) == 4102448399UL);
+	}
+}
+
+/**
+  * @brief  Timestamps formatted after the context was advanced without I2C access.
+  * @retval None
+  * @note   The formatters read usr->regs, which must follow ds1307_tick, the cached clock
+  *         and the incremental formatter across a rollover of every field.
+  */
+static void test_format_after_tick(void) {
+	ds1307_context_t rtc;
+	ds1307_cache_t cache;
+	ds1307_iso8601_t log_ts;
+	ds1307_sim_t sim;
+	char text[DS1307_ISO8601_SIZE];
+
+	test_setup(&rtc, &sim);
+	sim.regs[DS1307_SEC_REG_ADR] = 0x59;
+	sim.regs[DS1307_MIN_REG_ADR] = 0x59;
+	sim.regs[DS1307_HOUR_REG_ADR] = test_hour_reg(DS1307_HOUR_FORMAT_12, 23);
+	sim.regs[DS1307_DAY_REG_ADR] = 0x04;
+	sim.regs[DS1307_DATE_REG_ADR] = 0x31;
+	sim.regs[DS1307_MONTH_REG_ADR] = 0x12;
+	sim.regs[DS1307_YEAR_REG_ADR] = 0x25;
+	TEST_CHECK(ds1307_read_raw(&rtc) == DS1307_OK);
+	ds1307_iso8601_init(&log_ts, ' ');
+	TEST_CHECK(strcmp(ds1307_iso8601_update(&log_ts, &rtc),
+			"2025-12-31 23:59:59") == 0);
+
+	ds1307_tick(&rtc);
+	ds1307_format_iso8601(&rtc, text);
+	TEST_CHECK(strcmp(text, "2026-01-01T00:00:00") == 0);
+	TEST_CHECK(strcmp(ds1307_iso8601_update(&log_ts, &rtc),
+			"2026-01-01 00:00:00") == 0);
+	ds1307_add_seconds(&rtc, 13U * 3600U + 5U);
+	ds1307_format_log(&rtc, text);
+	TEST_CHECK(strcmp(text, "2026-01-01 13:00:05") == 0);
+
+	test_ms = 0;
+	TEST_CHECK(ds1307_cache_init(&cache, &rtc, test_tick_ms, 0) == DS1307_OK);
+	test_ms = 61500;
+	ds1307_format_log(ds1307_now(&cache), text);
+	TEST_CHECK(strcmp(text, "2026-01-01 00:01:00") == 0);
+	TEST_CHECK(sim.counters.transactions == 2U);
+}
+
+/**
+  * @brief  Drift correction with a cached clock that lags the device.
+  * @retval None
+  * @note   The cache was synced one second before the device ticked. The step must be taken from
+  *         a fresh device read, so exactly the recorded step is applied, and the stored region
+  *         must load back with the shared CRC-8.
+  */
+static void test_calib_cache(void) {
+	ds1307_context_t rtc;
+	ds1307_cache_t cache;
+	ds1307_calib_t calib;
+	ds1307_calib_t loaded;
+	ds1307_sim_t sim;
+	uint8_t restored;
+
+	test_setup(&rtc, &sim);
+	sim.regs[DS1307_SEC_REG_ADR] = 0x10;
+	test_ms = 0;
+	TEST_CHECK(ds1307_cache_init(&cache, &rtc, test_tick_ms, 0) == DS1307_OK);
+	ds1307_sim_tick(&sim);
+
+	TEST_CHECK(ds1307_calib_open(&calib, &rtc, 20, &restored) == DS1307_OK);
+	TEST_CHECK(restored == 0U);
+	calib.anchored = 1;
+	calib.anchor = DS1307_EPOCH_2000 + 10U - 10000U;
+	calib.drift_ppb = 100000L;
+	TEST_CHECK(ds1307_calib_error(&calib, ds1307_to_epoch(ds1307_now(&cache))) == 1);
+
+	TEST_CHECK(ds1307_calib_apply(&calib, &cache) == DS1307_OK);
+	TEST_CHECK(sim.regs[DS1307_SEC_REG_ADR] == 0x10U);
+	TEST_CHECK(calib.stepped == 1);
+	TEST_CHECK(rtc.second == 10U);
+
+	TEST_CHECK(ds1307_calib_sync(&calib, DS1307_EPOCH_2000 + 10U, NULL) == DS1307_OK);
+	TEST_CHECK(ds1307_calib_open(&loaded, &rtc, 20, &restored) == DS1307_OK);
+	TEST_CHECK(restored == 1U && loaded.anchor == calib.anchor
+			&& loaded.drift_ppb == calib.drift_ppb && loaded.stepped == calib.stepped);
+	sim.regs[20 + DS1307_RAM_START_ADR] ^= 0x01U;
+	TEST_CHECK(ds1307_calib_open(&loaded, &rtc, 20, &restored) == DS1307_OK);
+	TEST_CHECK(restored == 0U);
+}
+
+/**
+  * @brief  Multiplexer sweep into the compact device table and device select under the bus lock.
+  * @retval None
+  */
+static void test_mux(void) {
+	ds1307_context_t rtc;
+	ds1307_mux_device_t table[3];
+	ds1307_mux_t mux;
+	ds1307_sim_t sim;
+	ds1307_context_t *selected;
+
+	test_setup(&rtc, &sim);
+	ds1307_mux_init(&mux, table, 3, &rtc, test_mux_select, &sim);
+	TEST_CHECK(ds1307_mux_add(&mux, 5));
+	TEST_CHECK(ds1307_mux_add(&mux, 0));
+	TEST_CHECK(ds1307_mux_add(&mux, 2));
+	TEST_CHECK(!ds1307_mux_add(&mux, 2));
+	TEST_CHECK(table[0].channel == 0U && table[1].channel == 2U && table[2].channel == 5U);
+	TEST_CHECK(ds1307_mux_time(&mux, 1) == NULL);
+	test_mux_unlocked = 0;
+
+	TEST_CHECK(ds1307_mux_read_all(&mux) == DS1307_OK);
+	TEST_CHECK(test_mux_unlocked == 0U && sim.counters.unlocked == 0U);
+	TEST_CHECK(sim.counters.transactions == 3U && sim.lock_depth == 0U);
+	TEST_CHECK(ds1307_compact_second(ds1307_mux_time(&mux, 0)) == 0U);
+	TEST_CHECK(ds1307_compact_second(ds1307_mux_time(&mux, 2)) == 2U);
+	TEST_CHECK(ds1307_compact_second(ds1307_mux_time(&mux, 5)) == 5U);
+	TEST_CHECK(ds1307_compact_year(ds1307_mux_time(&mux, 5)) == 2000U);
+
+	selected = ds1307_mux_select_device(&mux, 1);
+	TEST_CHECK(selected == &rtc && test_mux_channel == 2U);
+	TEST_CHECK(test_mux_unlocked == 0U && sim.lock_depth == 1U);
+	TEST_CHECK(ds1307_get_second(selected) == DS1307_OK && rtc.second == 2U);
+	ds1307_unlock(selected);
+	TEST_CHECK(sim.lock_depth == 0U && sim.counters.unlocked == 0U);
+	TEST_CHECK(ds1307_mux_select_device(&mux, 3) == NULL && sim.lock_depth == 0U);
+}
+
+/**
+  * @brief  Startup check with transfer size limits from one byte up to the whole burst.
+  * @retval None
+  */
+static void test_init_chunks(void) {
+	ds1307_context_t rtc;
+	ds1307_sim_t sim;
+	ds1307_boot_t boot;
+	uint8_t limit;
+
+	for (limit = 0; limit <= DS1307_RAM_START_ADR + DS1307_INIT_MAGIC_SIZE; limit++) {
+		test_setup(&rtc, &sim);
+		rtc.sqw = DS1307_SQW_1HZ;
+		TEST_CHECK(ds1307_init_mark(&rtc) == DS1307_OK);
+		rtc.marked = 0;
+		sim.max_transfer = limit;
+		rtc.functions.max_transfer_size = limit;
+		sim.regs[DS1307_MIN_REG_ADR] = 0x42;
+		ds1307_sim_reset_counters(&sim);
+		TEST_CHECK(ds1307_init(&rtc, &boot) == DS1307_OK);
+		TEST_CHECK(boot == DS1307_BOOT_VALID && rtc.minute == 42U
+				&& rtc.sqw == DS1307_SQW_1HZ);
+		TEST_CHECK(sim.counters.transactions == (limit ?
+				(DS1307_RAM_START_ADR + DS1307_INIT_MAGIC_SIZE + limit - 1U) / limit : 1U));
+		TEST_CHECK(sim.counters.unlocked == 0U && sim.lock_depth == 0U);
+		TEST_CHECK(rtc.marked == 1U);
+	}
+}
+
+/**
+  * @brief  RAM marker CRC over the control register, its upkeep by ds1307_set_sqw and the
+  *         reservation of its RAM bytes.
+  * @retval None
+  */
+static void test_init_marker(void) {
+	ds1307_context_t rtc;
+	ds1307_sim_t sim;
+	ds1307_boot_t boot;
+	ds1307_journal_t journal;
+	ds1307_calib_t calib;
+	uint8_t base;
+
+	test_setup(&rtc, &sim);
+	TEST_CHECK(ds1307_init(&rtc, &boot) == DS1307_OK);
+	TEST_CHECK(boot == DS1307_BOOT_POWER_LOST && rtc.marked == 0U);
+	ds1307_sim_reset_counters(&sim);
+	TEST_CHECK(ds1307_set_sqw(&rtc, DS1307_SQW_4096HZ) == DS1307_OK);
+	TEST_CHECK(sim.counters.data_bytes == 1U && sim.regs[DS1307_RAM_START_ADR] == 0U);
+
+	TEST_CHECK(ds1307_init_mark(&rtc) == DS1307_OK && rtc.marked == 1U);
+	TEST_CHECK(sim.regs[DS1307_CONT_REG_ADR] == (uint8_t) DS1307_SQW_4096HZ);
+	TEST_CHECK(sim.regs[DS1307_RAM_START_ADR + 2U]
+			== ds1307_crc8(&sim.regs[DS1307_CONT_REG_ADR], 3U));
+	TEST_CHECK(ds1307_init(&rtc, &boot) == DS1307_OK && boot == DS1307_BOOT_VALID);
+
+	ds1307_sim_reset_counters(&sim);
+	TEST_CHECK(ds1307_set_sqw(&rtc, DS1307_SQW_1HZ) == DS1307_OK);
+	TEST_CHECK(sim.counters.transactions == 1U
+			&& sim.counters.data_bytes == 1U + DS1307_INIT_MAGIC_SIZE);
+	TEST_CHECK(ds1307_init(&rtc, &boot) == DS1307_OK && boot == DS1307_BOOT_VALID
+			&& rtc.sqw == DS1307_SQW_1HZ);
+
+	sim.regs[DS1307_CONT_REG_ADR] = (uint8_t) DS1307_SQW_8192HZ;
+	TEST_CHECK(ds1307_init(&rtc, &boot) == DS1307_OK && boot == DS1307_BOOT_CORRUPT);
+	TEST_CHECK(rtc.sqw == DS1307_SQW_1HZ && rtc.marked == 1U);
+
+	sim.regs[DS1307_RAM_START_ADR + 1U] ^= 0x01U;
+	TEST_CHECK(ds1307_init(&rtc, &boot) == DS1307_OK
+			&& boot == DS1307_BOOT_POWER_LOST && rtc.marked == 0U);
+
+	ds1307_sim_reset_counters(&sim);
+	for (base = 0; base < DS1307_INIT_MAGIC_SIZE; base++) {
+		TEST_CHECK(ds1307_journal_open(&journal, &rtc, base, 34, NULL)
+				== DS1307_INVALID_PARAM);
+		TEST_CHECK(ds1307_calib_open(&calib, &rtc, base, NULL)
+				== DS1307_INVALID_PARAM);
+	}
+	TEST_CHECK(sim.counters.transactions == 0U);
+	TEST_CHECK(ds1307_journal_open(&journal, &rtc, DS1307_INIT_MAGIC_SIZE, 34, NULL)
+			== DS1307_OK);
+	TEST_CHECK(ds1307_calib_open(&calib, &rtc, 40, NULL) == DS1307_OK);
+}
+
+/**
+  * @brief  Journal ring buffer: wrap, recovery on reopen, torn appends and CRC failures.
+  * @retval None
+  * @note   An append is torn by failing its header write after the record write went through,
+  *         as a reset between the two transfers would.
+  */
+static void test_journal(void) {
+	ds1307_context_t rtc;
+	ds1307_sim_t sim;
+	ds1307_journal_t journal;
+	ds1307_journal_t reopened;
+	ds1307_journal_record_t record;
+	uint8_t recovered = 0xFF;
+	uint8_t i;
+
+	test_setup(&rtc, &sim);
+	rtc.functions.ds1307_i2c_send_ptr = test_flaky_write;
+	TEST_CHECK(ds1307_journal_open(&journal, &rtc, 22, 34, &recovered) == DS1307_OK);
+	TEST_CHECK(recovered == 0U && journal.capacity == 5U && journal.count == 0U);
+	TEST_CHECK(ds1307_journal_read(&journal, 0, &record) == DS1307_INVALID_PARAM);
+
+	/* filling: a torn append drops the new record */
+	TEST_CHECK(ds1307_journal_append(&journal, 1000, 0) == DS1307_OK);
+	TEST_CHECK(ds1307_journal_append(&journal, 1001, 1) == DS1307_OK);
+	test_writes_left = 1;
+	TEST_CHECK(ds1307_journal_append(&journal, 9999, 99) == DS1307_ERROR);
+	TEST_CHECK(journal.count == 2U && journal.head == 2U);
+	TEST_CHECK(ds1307_journal_open(&reopened, &rtc, 22, 34, &recovered) == DS1307_OK);
+	TEST_CHECK(recovered == 1U && reopened.count == 2U && reopened.head == 2U);
+	TEST_CHECK(ds1307_journal_read(&reopened, 1, &record) == DS1307_OK
+			&& record.epoch == 1001UL && record.code == 1U);
+
+	/* wrap: the oldest records are overwritten */
+	for (i = 2; i < 8U; i++) {
+		TEST_CHECK(ds1307_journal_append(&journal, 1000UL + i, i) == DS1307_OK);
+	}
+	TEST_CHECK(journal.count == 5U && journal.head == 3U);
+	for (i = 0; i < 5U; i++) {
+		TEST_CHECK(ds1307_journal_read(&journal, i, &record) == DS1307_OK
+				&& record.epoch == 1003UL + i && record.code == 3U + i);
+	}
+	TEST_CHECK(ds1307_journal_read(&journal, 5, &record) == DS1307_INVALID_PARAM);
+	TEST_CHECK(ds1307_journal_open(&reopened, &rtc, 22, 34, &recovered) == DS1307_OK);
+	TEST_CHECK(recovered == 1U && reopened.count == 5U && reopened.head == 3U);
+	TEST_CHECK(ds1307_journal_read(&reopened, 0, &record) == DS1307_OK
+			&& record.epoch == 1003UL && record.code == 3U);
+
+	/* full: a torn append leaves the new record in the slot of the oldest one */
+	test_writes_left = 1;
+	TEST_CHECK(ds1307_journal_append(&journal, 2000, 20) == DS1307_ERROR);
+	TEST_CHECK(journal.count == 5U && journal.head == 3U);
+	TEST_CHECK(ds1307_journal_open(&reopened, &rtc, 22, 34, &recovered) == DS1307_OK);
+	TEST_CHECK(recovered == 1U && reopened.head == 3U);
+	TEST_CHECK(ds1307_journal_read(&reopened, 0, &record) == DS1307_OK
+			&& record.epoch == 2000UL && record.code == 20U);
+	TEST_CHECK(ds1307_journal_read(&reopened, 1, &record) == DS1307_OK
+			&& record.epoch == 1004UL);
+
+	/* a record cut short fails its CRC, the others still read */
+	sim.regs[DS1307_RAM_START_ADR + 22U + 3U + 3U * 6U + 4U] ^= 0x5AU;
+	TEST_CHECK(ds1307_journal_read(&reopened, 0, &record) == DS1307_INVALID_DATA);
+	TEST_CHECK(ds1307_journal_read(&reopened, 4, &record) == DS1307_OK
+			&& record.epoch == 1007UL);
+
+	/* a failed record write changes nothing */
+	sim.fail_count = 1;
+	TEST_CHECK(ds1307_journal_append(&reopened, 3000, 30) == DS1307_ERROR);
+	TEST_CHECK(reopened.count == 5U && reopened.head == 3U);
+
+	/* a damaged header formats the region */
+	sim.regs[DS1307_RAM_START_ADR + 22U] ^= 0xFFU;
+	TEST_CHECK(ds1307_journal_open(&reopened, &rtc, 22, 34, &recovered) == DS1307_OK);
+	TEST_CHECK(recovered == 0U && reopened.count == 0U && reopened.head == 0U);
+}
+
+/**
+  * @brief  Deferred setters: ds1307_commit writes the smallest span covering the dirty fields.
+  * @retval None
+  */
+static void test_commit_span(void) {
+	static const uint8_t image[DS1307_TIME_REG_COUNT] = { 0x12, 0x34, 0x08,
+			0x02, 0x15, 0x06, 0x25 };
+	ds1307_context_t rtc;
+	ds1307_sim_t sim;
+
+	test_setup(&rtc, &sim);
+	memcpy(sim.regs, image, sizeof(image));
+	TEST_CHECK(ds1307_read_raw(&rtc) == DS1307_OK);
+	ds1307_set_write_mode(&rtc, DS1307_WRITE_DEFERRED);
+	ds1307_sim_reset_counters(&sim);
+	TEST_CHECK(ds1307_commit(&rtc) == DS1307_OK);
+	TEST_CHECK(sim.counters.transactions == 0U);
+
+	/* the model changes behind the image; registers outside the span keep their value */
+	sim.regs[DS1307_SEC_REG_ADR] = 0x40;
+	sim.regs[DS1307_YEAR_REG_ADR] = 0x26;
+	TEST_CHECK(ds1307_set_date(&rtc, 20) == DS1307_OK);
+	TEST_CHECK(ds1307_set_minute(&rtc, 45) == DS1307_OK);
+	TEST_CHECK(sim.counters.transactions == 0U && sim.regs[DS1307_MIN_REG_ADR] == 0x34U);
+	TEST_CHECK(ds1307_minute(&rtc) == 45U && ds1307_date(&rtc) == 20U);
+	TEST_CHECK(ds1307_commit(&rtc) == DS1307_OK);
+	TEST_CHECK(sim.counters.transactions == 1U && sim.counters.data_bytes == 4U);
+	TEST_CHECK(sim.regs[DS1307_SEC_REG_ADR] == 0x40U && sim.regs[DS1307_MIN_REG_ADR] == 0x45U
+			&& sim.regs[DS1307_HOUR_REG_ADR] == 0x08U && sim.regs[DS1307_DAY_REG_ADR] == 0x02U
+			&& sim.regs[DS1307_DATE_REG_ADR] == 0x20U && sim.regs[DS1307_MONTH_REG_ADR] == 0x06U
+			&& sim.regs[DS1307_YEAR_REG_ADR] == 0x26U);
+	ds1307_sim_reset_counters(&sim);
+	TEST_CHECK(ds1307_commit(&rtc) == DS1307_OK && sim.counters.transactions == 0U);
+
+	/* a single field is a single byte */
+	TEST_CHECK(ds1307_set_month(&rtc, DS1307_NOVEMBER) == DS1307_OK);
+	TEST_CHECK(ds1307_commit(&rtc) == DS1307_OK);
+	TEST_CHECK(sim.counters.transactions == 1U && sim.counters.data_bytes == 1U
+			&& sim.regs[DS1307_MONTH_REG_ADR] == 0x11U);
+
+	/* a failed commit keeps the dirty fields for the next one */
+	TEST_CHECK(ds1307_set_second(&rtc, 7) == DS1307_OK);
+	TEST_CHECK(ds1307_set_year(&rtc, 2031) == DS1307_OK);
+	sim.fail_count = 1;
+	TEST_CHECK(ds1307_commit(&rtc) == DS1307_ERROR);
+	TEST_CHECK(sim.regs[DS1307_SEC_REG_ADR] == 0x40U && sim.regs[DS1307_YEAR_REG_ADR] == 0x26U);
+	ds1307_sim_reset_counters(&sim);
+	TEST_CHECK(ds1307_commit(&rtc) == DS1307_OK);
+	TEST_CHECK(sim.counters.transactions == 1U
+			&& sim.counters.data_bytes == DS1307_TIME_REG_COUNT);
+	TEST_CHECK(sim.regs[DS1307_SEC_REG_ADR] == 0x07U && sim.regs[DS1307_YEAR_REG_ADR] == 0x31U
+			&& sim.regs[DS1307_MONTH_REG_ADR] == 0x11U);
+
+	/* immediate mode writes right away again */
+	ds1307_set_write_mode(&rtc, DS1307_WRITE_IMMEDIATE);
+	ds1307_sim_reset_counters(&sim);
+	TEST_CHECK(ds1307_set_hour(&rtc, 9) == DS1307_OK);
+	TEST_CHECK(sim.counters.transactions == 1U && sim.regs[DS1307_HOUR_REG_ADR] == 0x09U);
+}
+
+/**
+  * @brief  Bus handle: two contexts sharing the same transport functions reach only their own device.
+  * @retval None
+  */
+static void test_bus_handle(void) {
+	ds1307_context_t rtc[2];
+	ds1307_sim_t sim[2];
+	uint8_t data[4] = { 0xDE, 0xAD, 0xBE, 0xEF };
+	uint8_t i;
+
+	for (i = 0; i < 2U; i++) {
+		test_setup(&rtc[i], &sim[i]);
+	}
+	TEST_CHECK(rtc[0].functions.ds1307_i2c_send_ptr == rtc[1].functions.ds1307_i2c_send_ptr
+			&& rtc[0].functions.handle != rtc[1].functions.handle);
+
+	TEST_CHECK(ds1307_set_minute(&rtc[0], 12) == DS1307_OK);
+	TEST_CHECK(ds1307_set_minute(&rtc[1], 34) == DS1307_OK);
+	TEST_CHECK(sim[0].regs[DS1307_MIN_REG_ADR] == 0x12U
+			&& sim[1].regs[DS1307_MIN_REG_ADR] == 0x34U);
+	TEST_CHECK(ds1307_nvram_write(&rtc[1], 10, data, sizeof(data)) == DS1307_OK);
+	TEST_CHECK(sim[0].regs[DS1307_RAM_START_ADR + 10U] == 0U
+			&& sim[1].regs[DS1307_RAM_START_ADR + 10U] == 0xDEU);
+
+	sim[0].regs[DS1307_HOUR_REG_ADR] = 0x07;
+	sim[1].regs[DS1307_HOUR_REG_ADR] = 0x19;
+	ds1307_sim_reset_counters(&sim[0]);
+	ds1307_sim_reset_counters(&sim[1]);
+	TEST_CHECK(DS1307_read_date_time(&rtc[1]) == DS1307_OK && rtc[1].hour == 19U
+			&& rtc[1].minute == 34U);
+	TEST_CHECK(DS1307_read_date_time(&rtc[0]) == DS1307_OK && rtc[0].hour == 7U
+			&& rtc[0].minute == 12U);
+	TEST_CHECK(sim[0].counters.transactions == 1U && sim[1].counters.transactions == 1U);
+
+	/* the lock hooks get the handle of their own bus */
+	ds1307_lock(&rtc[0]);
+	TEST_CHECK(sim[0].lock_depth == 1U && sim[1].lock_depth == 0U);
+	ds1307_unlock(&rtc[0]);
+	TEST_CHECK(sim[0].lock_depth == 0U);
+
+	/* a failure on one bus does not affect the other */
+	sim[0].fail_count = 1;
+	TEST_CHECK(ds1307_get_minute(&rtc[0]) == DS1307_ERROR);
+	TEST_CHECK(ds1307_get_minute(&rtc[1]) == DS1307_OK && rtc[1].minute == 34U);
+	TEST_CHECK(ds1307_get_minute(&rtc[0]) == DS1307_OK && rtc[0].minute == 12U);
+}
+
+/**
+  * @brief  NVRAM bulk and stream access: chunking at the transport limit, range checks and clipping
+  *         at the end of the RAM.
+  * @retval None
+  */
+static void test_nvram(void) {
+	ds1307_context_t rtc;
+	ds1307_sim_t sim;
+	ds1307_nvram_stream_t stream;
+	uint8_t data[DS1307_RAM_SIZE];
+	uint8_t back[DS1307_RAM_SIZE];
+	uint8_t fill[10];
+	uint8_t count = 0xFF;
+	uint8_t i;
+
+	test_setup(&rtc, &sim);
+	for (i = 0; i < DS1307_RAM_SIZE; i++) {
+		data[i] = (uint8_t) (i * 37U + 1U);
+	}
+	memset(fill, 0xA5, sizeof(fill));
+	rtc.functions.max_transfer_size = 8;
+	sim.max_transfer = 8;
+	TEST_CHECK(ds1307_nvram_write(&rtc, 0, data, DS1307_RAM_SIZE) == DS1307_OK);
+	TEST_CHECK(sim.counters.transactions == DS1307_RAM_SIZE / 8U);
+	TEST_CHECK(memcmp(&sim.regs[DS1307_RAM_START_ADR], data, DS1307_RAM_SIZE) == 0);
+	ds1307_sim_reset_counters(&sim);
+	memset(back, 0, sizeof(back));
+	TEST_CHECK(ds1307_nvram_read(&rtc, 5, back, 20) == DS1307_OK);
+	TEST_CHECK(sim.counters.transactions == 3U && sim.counters.data_bytes == 20U);
+	TEST_CHECK(memcmp(back, &data[5], 20) == 0);
+
+	ds1307_sim_reset_counters(&sim);
+	TEST_CHECK(ds1307_nvram_read(&rtc, 3, back, DS1307_RAM_SIZE - 2U) == DS1307_INVALID_PARAM);
+	TEST_CHECK(ds1307_nvram_write(&rtc, DS1307_RAM_SIZE, data, 1) == DS1307_INVALID_PARAM);
+	TEST_CHECK(ds1307_nvram_read(&rtc, DS1307_RAM_SIZE - 1U, back, 1) == DS1307_OK);
+	TEST_CHECK(sim.counters.transactions == 1U && back[0] == data[DS1307_RAM_SIZE - 1U]);
+
+	/* streams clip at the end of the RAM */
+	ds1307_nvram_stream_open(&stream, &rtc, 50);
+	ds1307_sim_reset_counters(&sim);
+	TEST_CHECK(ds1307_nvram_stream_write(&stream, fill, 10, &count) == DS1307_OK);
+	TEST_CHECK(count == 6U && stream.offset == DS1307_RAM_SIZE);
+	TEST_CHECK(sim.counters.data_bytes == 6U);
+	TEST_CHECK(ds1307_nvram_stream_write(&stream, fill, 10, &count) == DS1307_OK && count == 0U);
+	TEST_CHECK(sim.counters.data_bytes == 6U);
+
+	ds1307_nvram_stream_open(&stream, &rtc, 0);
+	for (i = 0; i < 3U; i++) {
+		TEST_CHECK(ds1307_nvram_stream_read(&stream, &back[i * 20U], 20, &count) == DS1307_OK);
+	}
+	TEST_CHECK(count == DS1307_RAM_SIZE - 40U && stream.offset == DS1307_RAM_SIZE);
+	TEST_CHECK(memcmp(back, data, 50) == 0);
+	TEST_CHECK(memcmp(&back[50], fill, DS1307_RAM_SIZE - 50U) == 0);
+
+	/* a failed chunk fails the call and does not advance the stream */
+	rtc.functions.ds1307_i2c_send_ptr = test_flaky_write;
+	ds1307_nvram_stream_open(&stream, &rtc, 10);
+	test_writes_left = 1;
+	TEST_CHECK(ds1307_nvram_stream_write(&stream, data, 16, &count) == DS1307_ERROR);
+	TEST_CHECK(count == 0U && stream.offset == 10U);
+	TEST_CHECK(ds1307_nvram_stream_write(&stream, data, 16, &count) == DS1307_OK);
+	TEST_CHECK(count == 16U && stream.offset == 26U);
+	TEST_CHECK(memcmp(&sim.regs[DS1307_RAM_START_ADR + 10U], data, 16) == 0);
+}
+
+/**
+  * @brief  Alarm callback of the alarm tests (@ref ds1307_alarm_func_t); logs the alarms in firing order.
+  * @param  id: Identifier of the alarm.
+  * @param  deadline: Deadline it fired for.
+  * @param  user: Unused.
+  * @retval None
+  */
+static void test_alarm_fire(uint8_t id, uint32_t deadline, void *user) {
+	(void) user;
+	if (test_alarm_count < sizeof(test_alarm_ids)) {
+		test_alarm_ids[test_alarm_count] = id;
+		test_alarm_deadlines[test_alarm_count] = deadline;
+	}
+	test_alarm_count++;
+}
+
+/**
+  * @brief  Alarms fed from the simulated clock across midnight fire in deadline order, whatever order
+  *         they were added in, and a late tick fires a periodic alarm once.
+  * @retval None
+  */
+static void test_alarm_midnight(void) {
+	static const uint8_t start[DS1307_TIME_REG_COUNT] = { 0x50, 0x59, 0x23,
+			0x05, 0x13, 0x06, 0x25 };
+	const uint32_t midnight = 1749859200UL;
+	ds1307_context_t rtc;
+	ds1307_sim_t sim;
+	ds1307_alarm_engine_t engine;
+	ds1307_alarm_t pool[8];
+	uint8_t id[9];
+	uint8_t i;
+
+	test_setup(&rtc, &sim);
+	memcpy(sim.regs, start, sizeof(start));
+	TEST_CHECK(DS1307_read_date_time(&rtc) == DS1307_OK);
+	TEST_CHECK(ds1307_to_epoch(&rtc) == midnight - 10U);
+	ds1307_alarm_init(&engine, pool, 8, ds1307_to_epoch(&rtc));
+	test_alarm_count = 0;
+
+	id[0] = ds1307_alarm_add(&engine, midnight + 5U, 0, test_alarm_fire, NULL);
+	id[1] = ds1307_alarm_add(&engine, midnight - 5U, 0, test_alarm_fire, NULL);
+	id[2] = ds1307_alarm_add(&engine, midnight, 0, test_alarm_fire, NULL);
+	id[3] = ds1307_alarm_add(&engine, midnight - 2U, 3, test_alarm_fire, NULL);
+	id[4] = ds1307_alarm_add(&engine, midnight + 2U, 0, test_alarm_fire, NULL);
+	id[5] = ds1307_alarm_add(&engine, midnight - 1U, 0, test_alarm_fire, NULL);
+	for (i = 0; i < 6U; i++) {
+		TEST_CHECK(id[i] != 0U);
+	}
+	TEST_CHECK(ds1307_alarm_cancel(&engine, id[4]) == 1U);
+	TEST_CHECK(ds1307_alarm_cancel(&engine, id[4]) == 0U);
+	TEST_CHECK(ds1307_alarm_next(&engine) == midnight - 5U);
+
+	for (i = 0; i < 15U; i++) {
+		ds1307_sim_tick(&sim);
+		TEST_CHECK(DS1307_read_date_time(&rtc) == DS1307_OK);
+		ds1307_alarm_tick(&engine, ds1307_to_epoch(&rtc));
+	}
+	TEST_CHECK(rtc.date == 14U && rtc.day == DS1307_SATURDAY && rtc.hour == 0U
+			&& rtc.second == 5U);
+	TEST_CHECK(test_alarm_count == 7U);
+	TEST_CHECK(test_alarm_ids[0] == id[1] && test_alarm_deadlines[0] == midnight - 5U);
+	TEST_CHECK(test_alarm_ids[1] == id[3] && test_alarm_deadlines[1] == midnight - 2U);
+	TEST_CHECK(test_alarm_ids[2] == id[5] && test_alarm_deadlines[2] == midnight - 1U);
+	TEST_CHECK(test_alarm_ids[3] == id[2] && test_alarm_deadlines[3] == midnight);
+	TEST_CHECK(test_alarm_ids[4] == id[3] && test_alarm_deadlines[4] == midnight + 1U);
+	TEST_CHECK(test_alarm_ids[5] == id[3] && test_alarm_deadlines[5] == midnight + 4U);
+	TEST_CHECK(test_alarm_ids[6] == id[0] && test_alarm_deadlines[6] == midnight + 5U);
+	TEST_CHECK(engine.count == 1U && ds1307_alarm_next(&engine) == midnight + 7U);
+
+	/* one late read: everything due fires in deadline order, the periodic alarm once */
+	id[6] = ds1307_alarm_add(&engine, midnight + 20U, 0, test_alarm_fire, NULL);
+	id[7] = ds1307_alarm_add(&engine, midnight + 10U, 0, test_alarm_fire, NULL);
+	id[8] = ds1307_alarm_add(&engine, midnight + 15U, 0, test_alarm_fire, NULL);
+	for (i = 0; i < 25U; i++) {
+		ds1307_sim_tick(&sim);
+	}
+	TEST_CHECK(DS1307_read_date_time(&rtc) == DS1307_OK);
+	TEST_CHECK(ds1307_to_epoch(&rtc) == midnight + 30U);
+	test_alarm_count = 0;
+	ds1307_alarm_tick(&engine, ds1307_to_epoch(&rtc));
+	TEST_CHECK(test_alarm_count == 4U);
+	TEST_CHECK(test_alarm_ids[0] == id[3] && test_alarm_deadlines[0] == midnight + 7U);
+	TEST_CHECK(test_alarm_ids[1] == id[7] && test_alarm_ids[2] == id[8]
+			&& test_alarm_ids[3] == id[6]);
+	TEST_CHECK(engine.count == 1U && ds1307_alarm_next(&engine) == midnight + 31U);
+}
+
+/**
+  * @brief  Time zone conversion of the simulated UTC clock across the spring-forward and fall-back
+  *         transitions of the central European rules.
+  * @retval None
+  */
+static void test_tz_transitions(void) {
+	static const ds1307_tz_zone_t cet = { 3600, 7200,
+			{ 3, 5, DS1307_SUNDAY, 7200 }, { 10, 5, DS1307_SUNDAY, 10800 } };
+	static const ds1307_tz_zone_t utc = { 0, 0, { 0, 0, DS1307_SUNDAY, 0 },
+			{ 0, 0, DS1307_SUNDAY, 0 } };
+	static const uint8_t spring[DS1307_TIME_REG_COUNT] = { 0x58, 0x59, 0x00,
+			0x07, 0x30, 0x03, 0x25 };
+	static const uint8_t fall[DS1307_TIME_REG_COUNT] = { 0x58, 0x59, 0x00,
+			0x07, 0x26, 0x10, 0x25 };
+	static const uint8_t spring_hour[4] = { 1, 1, 3, 3 };
+	static const uint8_t minute[4] = { 59, 59, 0, 0 };
+	static const uint8_t second[4] = { 58, 59, 0, 1 };
+	ds1307_context_t rtc;
+	ds1307_context_t local;
+	ds1307_sim_t sim;
+	ds1307_tz_t tz;
+	uint8_t i;
+
+	test_setup(&rtc, &sim);
+	memset(&local, 0, sizeof(local));
+	local.time_format = DS1307_HOUR_FORMAT_24;
+	ds1307_tz_init(&tz, &cet);
+
+	memcpy(sim.regs, spring, sizeof(spring));
+	for (i = 0; i < 4U; i++) {
+		TEST_CHECK(DS1307_read_date_time(&rtc) == DS1307_OK);
+		ds1307_from_epoch(&local, ds1307_tz_local(&tz, ds1307_to_epoch(&rtc)));
+		TEST_CHECK(local.hour == spring_hour[i] && local.minute == minute[i]
+				&& local.second == second[i] && local.date == 30U);
+		TEST_CHECK(tz.dst == (i >= 2U));
+		TEST_CHECK(ds1307_tz_next(&tz) == (i < 2U ? 1743296400UL : 1761440400UL));
+		ds1307_sim_tick(&sim);
+	}
+
+	/* the local hour from 02:00 to 03:00 repeats */
+	memcpy(sim.regs, fall, sizeof(fall));
+	for (i = 0; i < 4U; i++) {
+		TEST_CHECK(DS1307_read_date_time(&rtc) == DS1307_OK);
+		ds1307_from_epoch(&local, ds1307_tz_local(&tz, ds1307_to_epoch(&rtc)));
+		TEST_CHECK(local.hour == 2U && local.minute == minute[i]
+				&& local.second == second[i] && local.date == 26U);
+		TEST_CHECK(tz.dst == (i < 2U));
+		ds1307_sim_tick(&sim);
+	}
+	TEST_CHECK(tz.offset == 3600L && ds1307_tz_next(&tz) > 1761440400UL);
+
+	/* going back in time evaluates the rules again */
+	TEST_CHECK(ds1307_tz_local(&tz, 1743296399UL) == 1743296399UL + 3600U && !tz.dst);
+	TEST_CHECK(ds1307_tz_local(&tz, 1743296400UL) == 1743296400UL + 7200U && tz.dst);
+
+	ds1307_tz_init(&tz, &utc);
+	TEST_CHECK(ds1307_tz_local(&tz, 1743296400UL) == 1743296400UL);
+	TEST_CHECK(ds1307_tz_next(&tz) == 0xFFFFFFFFUL);
+}
+
+/**
+  * @brief  Notification function of the scheduler tests (@ref ds1307_sched_notify_func_t).
+  * @param  rtc: Context of the scheduler.
+  * @param  events: Events reported.
+  * @param  user: Two bytes: number of notifications and the events of the last one.
+  * @retval None
+  */
+static void test_sched_notify(const ds1307_context_t *rtc, uint8_t events, void *user) {
+	uint8_t *log = (uint8_t*) user;
+
+	(void) rtc;
+	log[0]++;
+	log[1] = events;
+}
+
+/**
+  * @brief  Scheduler: one read per refresh, events worked out from the register diff, and only the
+  *         subscribers of those events notified.
+  * @retval None
+  */
+static void test_sched_events(void) {
+	static const uint8_t start[DS1307_TIME_REG_COUNT] = { 0x58, 0x59, 0x23,
+			0x02, 0x31, 0x12, 0x24 };
+	ds1307_context_t rtc;
+	ds1307_sim_t sim;
+	ds1307_sched_t sched;
+	ds1307_sched_subscriber_t subscribers[2];
+	uint8_t coarse[2] = { 0, 0 };
+	uint8_t fine[2] = { 0, 0 };
+
+	test_setup(&rtc, &sim);
+	memcpy(sim.regs, start, sizeof(start));
+	test_ms = 0;
+	ds1307_sched_init(&sched, &rtc, subscribers, 2, test_tick_ms, 1000);
+	TEST_CHECK(ds1307_sched_subscribe(&sched, DS1307_EVENT_MINUTE | DS1307_EVENT_DAY,
+			test_sched_notify, coarse));
+	TEST_CHECK(ds1307_sched_subscribe(&sched, DS1307_EVENT_SECOND, test_sched_notify, fine));
+
+	/* the first refresh reports everything */
+	TEST_CHECK(ds1307_sched_refresh(&sched) == DS1307_OK);
+	TEST_CHECK(coarse[0] == 1U && coarse[1] == (DS1307_EVENT_MINUTE | DS1307_EVENT_DAY));
+	TEST_CHECK(fine[0] == 1U && fine[1] == DS1307_EVENT_SECOND);
+
+	/* not due yet, then due without a change */
+	ds1307_sim_reset_counters(&sim);
+	test_ms = 999;
+	TEST_CHECK(ds1307_sched_poll(&sched) == DS1307_OK && sim.counters.transactions == 0U);
+	test_ms = 1000;
+	TEST_CHECK(ds1307_sched_poll(&sched) == DS1307_OK && sim.counters.transactions == 1U);
+	TEST_CHECK(coarse[0] == 1U && fine[0] == 1U);
+
+	/* a new second only reaches the fine subscriber */
+	ds1307_sim_tick(&sim);
+	test_ms = 2000;
+	TEST_CHECK(ds1307_sched_poll(&sched) == DS1307_OK && sim.counters.transactions == 2U);
+	TEST_CHECK(coarse[0] == 1U && fine[0] == 2U && fine[1] == DS1307_EVENT_SECOND);
+
+	/* the SQW edge refreshes before the period; a failed read notifies nobody */
+	ds1307_sim_tick(&sim);
+	ds1307_sched_sqw_edge(&sched);
+	sim.fail_count = 1;
+	TEST_CHECK(ds1307_sched_poll(&sched) == DS1307_ERROR);
+	TEST_CHECK(coarse[0] == 1U && fine[0] == 2U);
+	ds1307_sched_sqw_edge(&sched);
+	TEST_CHECK(ds1307_sched_poll(&sched) == DS1307_OK);
+	TEST_CHECK(rtc.year == 2025U && rtc.month == DS1307_JANUARY && rtc.date == 1U);
+	TEST_CHECK(coarse[0] == 2U && coarse[1] == (DS1307_EVENT_MINUTE | DS1307_EVENT_DAY));
+	TEST_CHECK(fine[0] == 3U && fine[1] == DS1307_EVENT_SECOND);
+	ds1307_sim_reset_counters(&sim);
+	TEST_CHECK(ds1307_sched_poll(&sched) == DS1307_OK && sim.counters.transactions == 0U);
+
+	/* stopping the clock changes the seconds register only */
+	sim.regs[DS1307_SEC_REG_ADR] |= 0x80U;
+	TEST_CHECK(ds1307_sched_refresh(&sched) == DS1307_OK);
+	TEST_CHECK(coarse[0] == 2U && fine[0] == 4U);
+}
+
+/**
+  * @brief  Delay function of the retry tests (@ref ds1307_delay_func_t); logs the requested delays.
+  * @param  ms: Requested delay.
+  * @retval None
+  */
+static void test_delay(uint32_t ms) {
+	if (test_delay_count < sizeof(test_delays) / sizeof(test_delays[0])) {
+		test_delays[test_delay_count] = ms;
+	}
+	test_delay_count++;
+}
+
+/**
+  * @brief  Retry policy: failed transfers are repeated with a doubling delay, up to the retry count.
+  * @retval None
+  */
+static void test_retry(void) {
+	static const uint8_t image[DS1307_TIME_REG_COUNT] = { 0x15, 0x30, 0x12,
+			0x05, 0x13, 0x06, 0x25 };
+	ds1307_context_t rtc;
+	ds1307_sim_t sim;
+
+	test_setup(&rtc, &sim);
+	memcpy(sim.regs, image, sizeof(image));
+	rtc.functions.retries = 3;
+	rtc.functions.retry_delay_ms = 5;
+	rtc.functions.delay_ms = test_delay;
+
+	/* recovered on the third attempt */
+	test_delay_count = 0;
+	sim.fail_count = 2;
+	TEST_CHECK(DS1307_read_date_time(&rtc) == DS1307_OK);
+	TEST_CHECK(rtc.minute == 30U && rtc.hour == 12U && rtc.year == 2025U);
+	TEST_CHECK(sim.counters.transactions == 3U && sim.lock_depth == 0U);
+	TEST_CHECK(test_delay_count == 2U && test_delays[0] == 5U && test_delays[1] == 10U);
+
+	/* every attempt fails: one transfer plus three retries, the image is left alone */
+	ds1307_sim_reset_counters(&sim);
+	test_delay_count = 0;
+	sim.fail_count = 4;
+	TEST_CHECK(ds1307_set_minute(&rtc, 45) == DS1307_ERROR);
+	TEST_CHECK(sim.counters.transactions == 4U && sim.regs[DS1307_MIN_REG_ADR] == 0x30U);
+	TEST_CHECK(ds1307_minute(&rtc) == 30U && sim.lock_depth == 0U);
+	TEST_CHECK(test_delay_count == 3U && test_delays[0] == 5U && test_delays[1] == 10U
+			&& test_delays[2] == 20U);
+	TEST_CHECK(ds1307_set_minute(&rtc, 45) == DS1307_OK && sim.regs[DS1307_MIN_REG_ADR] == 0x45U);
+
+	/* a transfer the transport rejects is not retried */
+	ds1307_sim_reset_counters(&sim);
+	test_delay_count = 0;
+	sim.max_transfer = 4;
+	TEST_CHECK(ds1307_set_date_time(&rtc) == DS1307_INVALID_PARAM);
+	TEST_CHECK(sim.counters.transactions == 0U && test_delay_count == 0U);
+	sim.max_transfer = 0;
+
+	/* without a delay hook the retries follow each other at once */
+	rtc.functions.delay_ms = NULL;
+	rtc.functions.retries = 1;
+	sim.fail_count = 1;
+	TEST_CHECK(ds1307_get_second(&rtc) == DS1307_OK && rtc.second == 15U);
+	TEST_CHECK(sim.counters.transactions == 2U && test_delay_count == 0U);
+}
+
+/**
+  * @brief  Non-blocking start function of the async tests (@ref ds1307_i2c_async_start_func_t).
+  * @param  handle: The model.
+  * @param  dir: Transfer direction.
+  * @param  address: Device address.
+  * @param  reg_adr: First register.
+  * @param  data: Transfer buffer.
+  * @param  size: Number of bytes.
+  * @retval test_async_result; the transfer is only recorded, @ref test_async_poll runs it.
+  */
+static ds1307_status_t test_async_start(void *handle, ds1307_async_dir_t dir,
+		ds1307_adr_t address, ds1307_reg_adr_t reg_adr, uint8_t *data, uint16_t size) {
+	(void) handle;
+	test_async.dir = dir;
+	test_async.address = address;
+	test_async.reg_adr = reg_adr;
+	test_async.data = data;
+	test_async.size = size;
+	return test_async.result;
+}
+
+/**
+  * @brief  Poll function of the async tests (@ref ds1307_i2c_async_poll_func_t).
+  * @param  handle: The model.
+  * @retval DS1307_BUSY for the first test_async.polls calls, then the result of the recorded transfer.
+  */
+static ds1307_status_t test_async_poll(void *handle) {
+	if (test_async.polls) {
+		test_async.polls--;
+		return DS1307_BUSY;
+	}
+	if (test_async.dir == DS1307_ASYNC_DIR_WRITE) {
+		return ds1307_sim_write(handle, test_async.address, test_async.reg_adr,
+				test_async.data, test_async.size);
+	}
+	return ds1307_sim_read(handle, test_async.address, test_async.reg_adr,
+			test_async.data, test_async.size);
+}
+
+/**
+  * @brief  Completion callback of the async tests (@ref ds1307_async_done_func_t).
+  * @param  usr: Context the operation ran on.
+  * @param  status: Result of the transfer.
+  * @retval None
+  */
+static void test_async_done(ds1307_context_t *usr, ds1307_status_t status) {
+	TEST_CHECK(!ds1307_async_busy(usr));
+	test_async.done++;
+	test_async.status = status;
+}
+
+/**
+  * @brief  Asynchronous read and write: busy rejection, polled and interrupt completion, and the
+  *         return to idle after a failure.
+  * @retval None
+  */
+static void test_async_states(void) {
+	static const uint8_t image[DS1307_TIME_REG_COUNT] = { 0x07, 0x08, 0x09,
+			0x03, 0x10, 0x11, 0x26 };
+	ds1307_context_t rtc;
+	ds1307_sim_t sim;
+
+	test_setup(&rtc, &sim);
+	memcpy(sim.regs, image, sizeof(image));
+	rtc.time_format = DS1307_HOUR_FORMAT_24;
+	rtc.functions.ds1307_i2c_async_start_ptr = test_async_start;
+	rtc.functions.ds1307_i2c_async_poll_ptr = test_async_poll;
+	memset(&test_async, 0, sizeof(test_async));
+	test_async.result = DS1307_OK;
+
+	/* polled read */
+	TEST_CHECK(!ds1307_async_busy(&rtc) && ds1307_async_poll(&rtc) == DS1307_OK);
+	test_async.polls = 2;
+	TEST_CHECK(ds1307_read_date_time_async(&rtc, test_async_done) == DS1307_OK);
+	TEST_CHECK(ds1307_async_busy(&rtc) && test_async.size == DS1307_TIME_REG_COUNT
+			&& test_async.reg_adr == DS1307_SEC_REG_ADR);
+	TEST_CHECK(ds1307_read_date_time_async(&rtc, test_async_done) == DS1307_BUSY);
+	TEST_CHECK(ds1307_set_date_time_async(&rtc, test_async_done) == DS1307_BUSY);
+	TEST_CHECK(ds1307_async_poll(&rtc) == DS1307_BUSY);
+	TEST_CHECK(ds1307_async_poll(&rtc) == DS1307_BUSY);
+	TEST_CHECK(test_async.done == 0U && sim.counters.transactions == 0U);
+	TEST_CHECK(ds1307_async_poll(&rtc) == DS1307_OK);
+	TEST_CHECK(test_async.done == 1U && test_async.status == DS1307_OK);
+	TEST_CHECK(sim.counters.transactions == 1U && !ds1307_async_busy(&rtc));
+	TEST_CHECK(rtc.second == 7U && rtc.minute == 8U && rtc.hour == 9U
+			&& rtc.date == 10U && rtc.month == DS1307_NOVEMBER && rtc.year == 2026U);
+	TEST_CHECK(ds1307_async_poll(&rtc) == DS1307_OK && test_async.done == 1U);
+
+	/* the write is encoded when started, later changes to the context do not reach the device */
+	rtc.minute = 42;
+	TEST_CHECK(ds1307_set_date_time_async(&rtc, test_async_done) == DS1307_OK);
+	rtc.minute = 43;
+	TEST_CHECK(ds1307_async_poll(&rtc) == DS1307_OK && test_async.done == 2U);
+	TEST_CHECK(sim.regs[DS1307_MIN_REG_ADR] == 0x42U && sim.regs[DS1307_HOUR_REG_ADR] == 0x09U);
+
+	/* interrupt completion with an error: the context is not decoded */
+	sim.regs[DS1307_MIN_REG_ADR] = 0x59;
+	TEST_CHECK(ds1307_read_date_time_async(&rtc, test_async_done) == DS1307_OK);
+	ds1307_async_complete(&rtc, DS1307_ERROR);
+	TEST_CHECK(test_async.done == 3U && test_async.status == DS1307_ERROR);
+	TEST_CHECK(rtc.minute == 43U && !ds1307_async_busy(&rtc));
+	ds1307_async_complete(&rtc, DS1307_OK);
+	TEST_CHECK(test_async.done == 3U);
+
+	/* a failed start returns to idle without a callback; no callback is also fine */
+	test_async.result = DS1307_ERROR;
+	TEST_CHECK(ds1307_read_date_time_async(&rtc, test_async_done) == DS1307_ERROR);
+	TEST_CHECK(!ds1307_async_busy(&rtc) && test_async.done == 3U);
+	test_async.result = DS1307_OK;
+	TEST_CHECK(ds1307_read_date_time_async(&rtc, NULL) == DS1307_OK);
+	TEST_CHECK(ds1307_async_poll(&rtc) == DS1307_OK && rtc.minute == 59U);
+	TEST_CHECK(test_async.done == 3U && !ds1307_async_busy(&rtc));
+}
+
+/**
+  * @brief  Runs all tests.
+  * @retval 0 if every check passed, 1 otherwise.
+  */
+int main(void) {
+	test_bcd_codec();
+	test_image_fuzz();
+	test_encode_fuzz();
+	test_hour_round_trip();
+	test_write_back();
+	test_time_format();
+	test_calendar();
+	test_lazy_epoch();
+	test_format_after_tick();
+	test_calib_cache();
+	test_mux();
+	test_init_chunks();
+	test_init_marker();
+	test_journal();
+	test_commit_span();
+	test_bus_handle();
+	test_nvram();
+	test_alarm_midnight();
+	test_tz_transitions();
+	test_sched_events();
+	test_retry();
+	test_async_states();
+
+	printf("ds1307_test (codec %d): %lu checks, %lu failures\n",
+			DS1307_CONFIG_CODEC, test_checks, test_failures);
+	return test_failures ? 1 : 0;
+}